@@ -0,0 +1,162 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtadmissioncontrol.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+
+const int ADTAdmissionControl::DEFAULT_SLOTS = 0;
+
+// NOTE: /run/lock is world writable, so all users of the host share the same slots
+const char *const HOST_LOCK_DIRECTORY = "/run/lock/adt";
+const char *const SLOT_FILE_TEMPLATE  = "/slot-%1.lock";
+
+class ADTAdmissionControlPrivate
+{
+public:
+    ADTAdmissionControlPrivate(int slots)
+        : m_lockDir()
+        , m_descriptors(slots, -1)
+    {}
+
+    ~ADTAdmissionControlPrivate() = default;
+
+    QString m_lockDir;
+
+    // Descriptors of the lock files of the acquired slots, -1 if the slot is not held
+    std::vector<int> m_descriptors;
+
+private:
+    ADTAdmissionControlPrivate(const ADTAdmissionControlPrivate &) = delete;
+    ADTAdmissionControlPrivate(ADTAdmissionControlPrivate &&)      = delete;
+    ADTAdmissionControlPrivate &operator=(const ADTAdmissionControlPrivate &) = delete;
+    ADTAdmissionControlPrivate &operator=(ADTAdmissionControlPrivate &&) = delete;
+};
+
+ADTAdmissionControl::ADTAdmissionControl(int slots)
+    : d(std::make_unique<ADTAdmissionControlPrivate>(slots))
+{
+    d->m_lockDir = getLockDirectory();
+}
+
+ADTAdmissionControl::~ADTAdmissionControl()
+{
+    for (size_t i = 0; i < d->m_descriptors.size(); i++)
+    {
+        release(static_cast<int>(i));
+    }
+}
+
+int ADTAdmissionControl::tryAcquire()
+{
+    for (size_t i = 0; i < d->m_descriptors.size(); i++)
+    {
+        if (d->m_descriptors[i] != -1)
+        {
+            continue;
+        }
+
+        QByteArray path = QFile::encodeName(d->m_lockDir + QString(SLOT_FILE_TEMPLATE).arg(i));
+
+        // NOTE: flock doesn't need write access, so a lock file created by another user can be shared read-only.
+        // Symbolic links aren't followed, the directory may be writable by other users
+        int fd = open(path.constData(), O_RDONLY | O_CREAT | O_CLOEXEC | O_NOFOLLOW | O_NOCTTY, 0666);
+
+        if (fd == -1)
+        {
+            qWarning() << "WARNING! Can't open slot lock file: " << path;
+            continue;
+        }
+
+        if (flock(fd, LOCK_EX | LOCK_NB) == -1)
+        {
+            close(fd);
+            continue;
+        }
+
+        d->m_descriptors[i] = fd;
+
+        return static_cast<int>(i);
+    }
+
+    return -1;
+}
+
+void ADTAdmissionControl::release(int slot)
+{
+    if (slot < 0 || slot >= static_cast<int>(d->m_descriptors.size()) || d->m_descriptors[slot] == -1)
+    {
+        return;
+    }
+
+    flock(d->m_descriptors[slot], LOCK_UN);
+    close(d->m_descriptors[slot]);
+
+    d->m_descriptors[slot] = -1;
+}
+
+QString ADTAdmissionControl::getLockDirectory()
+{
+    // NOTE: the mode of a new directory is restricted by umask
+    if (mkdir(HOST_LOCK_DIRECTORY, 01777) == 0)
+    {
+        chmod(HOST_LOCK_DIRECTORY, 01777);
+    }
+
+    if (isSharedDirectory(HOST_LOCK_DIRECTORY))
+    {
+        return HOST_LOCK_DIRECTORY;
+    }
+
+    // NOTE: without access to /run/lock only processes of the same user are limited
+    QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation) + "/adt";
+
+    qWarning() << "WARNING! Can't use " << HOST_LOCK_DIRECTORY << ", falling back to " << runtimeDir;
+
+    QDir().mkpath(runtimeDir);
+
+    return runtimeDir;
+}
+
+bool ADTAdmissionControl::isSharedDirectory(QString path)
+{
+    struct stat info;
+
+    if (lstat(QFile::encodeName(path).constData(), &info) == -1 || !S_ISDIR(info.st_mode))
+    {
+        return false;
+    }
+
+    // NOTE: a directory created in advance by another user could let it replace the lock files
+    if (info.st_uid != 0 && info.st_uid != geteuid())
+    {
+        return false;
+    }
+
+    return (info.st_mode & 07777) == 01777;
+}
@@ -0,0 +1,63 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTADMISSIONCONTROL_H
+#define ADTADMISSIONCONTROL_H
+
+#include <memory>
+#include <QString>
+
+class ADTAdmissionControlPrivate;
+
+/*
+ * Limits the number of Run calls in flight across all adt processes of the host.
+ * Each call holds an exclusive flock on one of slot lock files in a shared directory,
+ * the locks are dropped by the kernel if the process dies.
+ */
+class ADTAdmissionControl
+{
+public:
+    static const int DEFAULT_SLOTS;
+
+public:
+    ADTAdmissionControl(int slots);
+    ~ADTAdmissionControl();
+
+    // Returns index of the acquired slot or -1 if all slots are busy
+    int tryAcquire();
+    void release(int slot);
+
+private:
+    static QString getLockDirectory();
+
+    // The directory is accepted only if it is owned by root or the current user and has mode 01777
+    static bool isSharedDirectory(QString path);
+
+private:
+    std::unique_ptr<ADTAdmissionControlPrivate> d;
+
+private:
+    ADTAdmissionControl(const ADTAdmissionControl &) = delete;
+    ADTAdmissionControl(ADTAdmissionControl &&)      = delete;
+    ADTAdmissionControl &operator=(const ADTAdmissionControl &) = delete;
+    ADTAdmissionControl &operator=(ADTAdmissionControl &&) = delete;
+};
+
+#endif // ADTADMISSIONCONTROL_H
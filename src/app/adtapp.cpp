@@ -21,9 +21,12 @@
 #include "adtapp.h"
 #include "../core/treemodelbulderfromexecutable.h"
 #include "adtbuilderstrategies/adtmodelbuilder.h"
+#include "adtbuilderstrategies/adtmodelbuilderstrategycatalogcache.h"
 #include "adtbuilderstrategies/adtmodelbuilderstrategydbusinfodesktop.h"
 #include "adtservicechecker.h"
+#include "adttarget.h"
 #include "clcontroller.h"
+#include "clmultitargetcontroller.h"
 #include "constants.h"
 #include "interfacedata.h"
 #include "interfaces/appcontrollerinterface.h"
@@ -33,6 +36,9 @@
 
 #include <iostream>
 #include <memory>
+#include <QDBusError>
+#include <QStandardPaths>
+#include <QThread>
 
 typedef CommandLineParser::CommandLineParseResult CommandLineParseResult;
 
@@ -52,6 +58,9 @@ public:
         , m_serviceChecker(new ADTServiceChecker(DBUS_SERVICE_NAME, PATH_TO_MANAGER_OBJECT, MANAGER_INTERFACE_NAME))
         , m_ifaceData(new InterfaceData())
         , m_dbusConnection(conn)
+        , m_targets()
+        , m_catalogCache(nullptr)
+        , m_revalidationThread(nullptr)
 
     {}
 
@@ -72,6 +81,12 @@ public:
 
     QDBusConnection m_dbusConnection;
 
+    std::vector<ADTTarget> m_targets;
+
+    std::unique_ptr<ADTCatalogCache> m_catalogCache;
+
+    QThread *m_revalidationThread;
+
 private:
     ADTAppPrivate(const ADTAppPrivate &) = delete;
     ADTAppPrivate(ADTAppPrivate &&)      = delete;
@@ -87,6 +102,14 @@ ADTApp::ADTApp(QApplication *application, ADTSettingsInterface *settings, QDBusC
 
 ADTApp::~ADTApp()
 {
+    if (d->m_revalidationThread)
+    {
+        // NOTE: discovery stops after the current object, its result isn't needed anymore
+        d->m_revalidationThread->requestInterruption();
+        d->m_revalidationThread->wait();
+        delete d->m_revalidationThread;
+    }
+
     delete d;
 }
 
@@ -113,17 +136,52 @@ int ADTApp::runApp()
         return 0;
     }
 
-    buildModel();
+    if (!d->m_options->busAddresses.isEmpty())
+    {
+        if (d->m_options->useGraphic)
+        {
+            std::cerr << "ERROR: multi-target mode is available only in command line interface" << std::endl;
+            return 1;
+        }
+
+        buildTargets();
+
+        d->m_appController = std::make_unique<CLMultiTargetController>(std::move(d->m_targets),
+                                                                       d->m_settings,
+                                                                       d->m_options.get());
+
+        return d->m_appController->runApp();
+    }
+
+    // NOTE: one-shot command line runs don't use the catalog cache, they would need a full discovery
+    // to revalidate it, while the lazy model asks only tools they use
+    d->m_model = d->m_options->useGraphic ? buildCachedModel() : nullptr;
+
+    bool isModelCached = d->m_model != nullptr;
+
+    if (!isModelCached)
+    {
+        // NOTE: tests of a tool are fetched when the tool is selected or run
+        d->m_model = buildModel(d->m_dbusConnection, nullptr, true);
+    }
 
     if (d->m_options->useGraphic == true)
     {
         //use GUI
-        d->m_appController = std::make_unique<MainWindowControllerImpl>(d->m_model.get(),
-                                                                        d->m_dbusConnection,
-                                                                        *d->m_ifaceData.get(),
-                                                                        d->m_settings,
-                                                                        d->m_options.get(),
-                                                                        d->m_application);
+        auto controller = std::make_unique<MainWindowControllerImpl>(d->m_model.get(),
+                                                                     d->m_dbusConnection,
+                                                                     *d->m_ifaceData.get(),
+                                                                     d->m_settings,
+                                                                     d->m_options.get(),
+                                                                     d->m_application);
+
+        // NOTE: without a cached model the discovery only fills the cache for the next start
+        if (d->m_catalogCache)
+        {
+            revalidateCatalog(isModelCached ? controller.get() : nullptr);
+        }
+
+        d->m_appController = std::move(controller);
     }
     else
     {
@@ -151,19 +209,155 @@ int ADTApp::runApp()
     return d->m_appController->runApp();
 }
 
-void ADTApp::buildModel()
+std::unique_ptr<TreeModel> ADTApp::buildModel(QDBusConnection conn, ADTCatalogCache *cache, bool lazyTests)
 {
-    ADTModelBuilder modelBuilder(new ADTModelBuilderStrategyDbusInfoDesktop(d->m_ifaceData->serviceName,
-                                                                            d->m_ifaceData->path,
-                                                                            d->m_ifaceData->managerInterface,
-                                                                            d->m_ifaceData->managerGetMethod,
-                                                                            d->m_ifaceData->ifaceName,
-                                                                            d->m_ifaceData->infoMethodName,
-                                                                            d->m_ifaceData->runMethodName,
-                                                                            d->m_ifaceData->reportMethodName,
-                                                                            new TreeModelBulderFromExecutable()));
-    d->m_model = std::move(modelBuilder.buildModel());
-    d->m_model->setLocaleForElements(d->m_locale);
+    auto strategy = new ADTModelBuilderStrategyDbusInfoDesktop(conn,
+                                                               d->m_ifaceData->serviceName,
+                                                               d->m_ifaceData->path,
+                                                               d->m_ifaceData->managerInterface,
+                                                               d->m_ifaceData->managerGetMethod,
+                                                               d->m_ifaceData->ifaceName,
+                                                               d->m_ifaceData->infoMethodName,
+                                                               d->m_ifaceData->runMethodName,
+                                                               d->m_ifaceData->reportMethodName,
+                                                               new TreeModelBulderFromExecutable());
+    strategy->setCatalogCache(cache);
+    strategy->setLazyTests(lazyTests);
+
+    ADTModelBuilder modelBuilder(strategy);
+    std::unique_ptr<TreeModel> model = modelBuilder.buildModel();
+    model->setLocaleForElements(d->m_locale);
+
+    return model;
+}
+
+std::unique_ptr<TreeModel> ADTApp::buildCachedModel()
+{
+    if (d->m_options->noCatalogCache)
+    {
+        return nullptr;
+    }
+
+    d->m_catalogCache = std::make_unique<ADTCatalogCache>(
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/catalog.json");
+
+    if (d->m_catalogCache->isEmpty())
+    {
+        return nullptr;
+    }
+
+    ADTModelBuilder modelBuilder(
+        new ADTModelBuilderStrategyCatalogCache(d->m_catalogCache.get(), new TreeModelBulderFromExecutable()));
+    std::unique_ptr<TreeModel> model = modelBuilder.buildModel();
+    model->setLocaleForElements(d->m_locale);
+
+    return model;
+}
+
+void ADTApp::revalidateCatalog(MainWindowControllerImpl *controller)
+{
+    QDBusConnection conn             = d->m_dbusConnection;
+    QMap<QString, QString> shownKeys = d->m_catalogCache->getKeys();
+
+    // NOTE: the cache is used only by this thread until the result is applied in the main thread
+    d->m_revalidationThread = QThread::create([this, conn, controller, shownKeys]() {
+        std::unique_ptr<TreeModel> model = buildModel(conn, d->m_catalogCache.get());
+
+        if (QThread::currentThread()->isInterruptionRequested() || !controller)
+        {
+            return;
+        }
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, controller, shownKeys]() { applyRevalidatedCatalog(controller, shownKeys); },
+            Qt::QueuedConnection);
+    });
+
+    d->m_revalidationThread->start(QThread::LowPriority);
+}
+
+void ADTApp::applyRevalidatedCatalog(MainWindowControllerImpl *controller, QMap<QString, QString> shownKeys)
+{
+    d->m_revalidationThread->wait();
+    delete d->m_revalidationThread;
+    d->m_revalidationThread = nullptr;
+
+    QMap<QString, QString> keys = d->m_catalogCache->getKeys();
+
+    QStringList removed;
+    std::vector<std::unique_ptr<ADTExecutable>> added;
+
+    for (auto it = shownKeys.begin(); it != shownKeys.end(); ++it)
+    {
+        if (keys.value(it.key()) != it.value())
+        {
+            removed.append(it.key());
+        }
+    }
+
+    // NOTE: executables are built from the cache in this thread, so they receive output of running tests
+    for (const QString &path : d->m_catalogCache->getPaths())
+    {
+        if (shownKeys.value(path) == keys.value(path))
+        {
+            continue;
+        }
+
+        for (auto &executable : d->m_catalogCache->find(path, keys.value(path)))
+        {
+            executable->setLocale(d->m_locale);
+            added.push_back(std::move(executable));
+        }
+    }
+
+    if (!removed.isEmpty() || !added.empty())
+    {
+        controller->updateObjects(removed, std::move(added));
+    }
+}
+
+void ADTApp::buildTargets()
+{
+    for (int i = 0; i < d->m_options->busAddresses.size(); i++)
+    {
+        ADTTarget target;
+        target.address    = d->m_options->busAddresses.at(i);
+        target.connection = QDBusConnection::connectToBus(target.address, QString("adt_target_%1").arg(i));
+
+        if (!target.connection.isConnected())
+        {
+            std::cerr << "ERROR: can't connect to bus: " << target.address.toStdString() << ": "
+                      << target.connection.lastError().message().toStdString() << std::endl;
+            continue;
+        }
+
+        d->m_targets.push_back(std::move(target));
+    }
+
+    // NOTE: discovery of each target runs in its own thread, elements of the built models
+    // are moved back to the main thread to receive output signals of running tests
+    QThread *mainThread = QThread::currentThread();
+    std::vector<QThread *> threads;
+
+    for (ADTTarget &target : d->m_targets)
+    {
+        ADTTarget *currentTarget = &target;
+
+        QThread *thread = QThread::create([this, currentTarget, mainThread]() {
+            currentTarget->model = buildModel(currentTarget->connection);
+            currentTarget->model->moveElementsToThread(mainThread);
+        });
+
+        threads.push_back(thread);
+        thread->start();
+    }
+
+    for (QThread *thread : threads)
+    {
+        thread->wait();
+        delete thread;
+    }
 }
 
 void ADTApp::initializeInterfaceData()
@@ -22,13 +22,17 @@
 #define ADTAPP_H
 
 #include "../core/treemodel.h"
+#include "adtcatalogcache.h"
 #include "adttoolobjecthelper.h"
 #include "settings/adtsettingsinterface.h"
 
+#include <memory>
 #include <QApplication>
 #include <QDBusConnection>
+#include <QMap>
 
 class ADTAppPrivate;
+class MainWindowControllerImpl;
 
 class ADTApp : public QObject
 {
@@ -40,7 +44,23 @@ public:
     int runApp();
 
 private:
-    void buildModel();
+    // With lazyTests only tools are discovered, tests are fetched by the model on request
+    std::unique_ptr<TreeModel> buildModel(QDBusConnection conn,
+                                          ADTCatalogCache *cache = nullptr,
+                                          bool lazyTests         = false);
+
+    // Returns nullptr if the catalog cache is disabled or empty
+    std::unique_ptr<TreeModel> buildCachedModel();
+
+    // Repeats discovery in a background thread to refresh the catalog cache, changed objects are then
+    // replaced in the shown model. If controller is nullptr, the shown model isn't from the cache
+    // and only the cache is written
+    void revalidateCatalog(MainWindowControllerImpl *controller);
+
+    // Called in the main thread when the discovery is finished, shownKeys are catalog keys of the shown model
+    void applyRevalidatedCatalog(MainWindowControllerImpl *controller, QMap<QString, QString> shownKeys);
+
+    void buildTargets();
     void initializeInterfaceData();
 
 private:
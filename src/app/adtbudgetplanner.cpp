@@ -0,0 +1,88 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtbudgetplanner.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Expected duration of a test which was never run before, msec
+const qint64 ADTBudgetPlanner::DEFAULT_DURATION = 5000;
+
+// Lower bound of the expected duration to not divide by zero, msec
+const qint64 MINIMAL_DURATION = 10;
+
+ADTBudgetPlanner::ADTBudgetPlanner(ADTRunHistory *history)
+    : m_history(history)
+{}
+
+std::vector<ADTExecutable *> ADTBudgetPlanner::plan(const std::vector<ADTExecutable *> &tasks,
+                                                    qint64 budget,
+                                                    std::vector<ADTExecutable *> &skipped)
+{
+    std::vector<ADTExecutable *> ranked(tasks.begin(), tasks.end());
+
+    std::stable_sort(ranked.begin(), ranked.end(), [this](ADTExecutable *first, ADTExecutable *second) {
+        return getFailureProbability(first) / getEstimatedDuration(first)
+               > getFailureProbability(second) / getEstimatedDuration(second);
+    });
+
+    std::vector<ADTExecutable *> planned;
+    qint64 plannedDuration = 0;
+
+    for (ADTExecutable *task : ranked)
+    {
+        qint64 duration = getEstimatedDuration(task);
+
+        if (plannedDuration + duration > budget)
+        {
+            skipped.push_back(task);
+            continue;
+        }
+
+        plannedDuration += duration;
+        planned.push_back(task);
+    }
+
+    return planned;
+}
+
+qint64 ADTBudgetPlanner::getEstimatedDuration(ADTExecutable *task)
+{
+    if (!m_history || !m_history->contains(task))
+    {
+        return DEFAULT_DURATION;
+    }
+
+    return std::max(MINIMAL_DURATION, static_cast<qint64>(std::ceil(m_history->getRecord(task).averageDuration)));
+}
+
+double ADTBudgetPlanner::getFailureProbability(ADTExecutable *task)
+{
+    if (!m_history)
+    {
+        return 0.5;
+    }
+
+    ADTRunHistory::Record record = m_history->getRecord(task);
+
+    // NOTE: Laplace estimate gives tests without history the probability of 0.5
+    return (record.failures + 1.0) / (record.runs + 2.0);
+}
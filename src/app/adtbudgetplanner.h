@@ -0,0 +1,60 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTBUDGETPLANNER_H
+#define ADTBUDGETPLANNER_H
+
+#include "adtrunhistory.h"
+
+#include <vector>
+
+/*
+ * Chooses and orders the subset of tests which fits into a time budget.
+ * Tests are ranked by the expected failure probability per second of their
+ * expected duration, both taken from the run history.
+ */
+class ADTBudgetPlanner
+{
+public:
+    static const qint64 DEFAULT_DURATION;
+
+public:
+    ADTBudgetPlanner(ADTRunHistory *history);
+    ~ADTBudgetPlanner() = default;
+
+    std::vector<ADTExecutable *> plan(const std::vector<ADTExecutable *> &tasks,
+                                      qint64 budget,
+                                      std::vector<ADTExecutable *> &skipped);
+
+    qint64 getEstimatedDuration(ADTExecutable *task);
+
+    double getFailureProbability(ADTExecutable *task);
+
+private:
+    ADTRunHistory *m_history;
+
+private:
+    ADTBudgetPlanner(const ADTBudgetPlanner &) = delete;
+    ADTBudgetPlanner(ADTBudgetPlanner &&)      = delete;
+    ADTBudgetPlanner &operator=(const ADTBudgetPlanner &) = delete;
+    ADTBudgetPlanner &operator=(ADTBudgetPlanner &&) = delete;
+};
+
+#endif // ADTBUDGETPLANNER_H
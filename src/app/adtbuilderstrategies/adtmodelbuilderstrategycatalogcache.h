@@ -0,0 +1,45 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTMODELBUILDERSTRATEGYCATALOGCACHE_H
+#define ADTMODELBUILDERSTRATEGYCATALOGCACHE_H
+
+#include "../core/treemodelbuilderinterface.h"
+#include "adtbuilderstrategies/adtmodelbuilderstrategyinterface.h"
+#include "adtcatalogcache.h"
+
+/*
+ * Builds the model from the catalog cache without D-Bus calls.
+ */
+class ADTModelBuilderStrategyCatalogCache : public ADTModelBuilderStrategyInterface
+{
+public:
+    ADTModelBuilderStrategyCatalogCache(ADTCatalogCache *cache, TreeModelBuilderInterface *builder);
+
+public:
+    std::unique_ptr<TreeModel> buildModel() override;
+
+private:
+    ADTCatalogCache *m_catalogCache;
+
+    std::unique_ptr<TreeModelBuilderInterface> m_treeModelBuilder;
+};
+
+#endif // ADTMODELBUILDERSTRATEGYCATALOGCACHE_H
@@ -21,14 +21,20 @@
 #include "adtmodelbuilderstrategydbusinfodesktop.h"
 #include "../core/adtdesktopfileparser.h"
 
+#include <QCryptographicHash>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingReply>
 #include <QDBusReply>
 #include <QDebug>
 #include <QJsonDocument>
+#include <QThreadPool>
 
 const QString ADTModelBuilderStrategyDbusInfoDesktop::LIST_METHOD = QString("List");
 const QString ADTModelBuilderStrategyDbusInfoDesktop::INFO_METHOD = QString("Info");
 
-ADTModelBuilderStrategyDbusInfoDesktop::ADTModelBuilderStrategyDbusInfoDesktop(QString serviceName,
+ADTModelBuilderStrategyDbusInfoDesktop::ADTModelBuilderStrategyDbusInfoDesktop(QDBusConnection conn,
+                                                                               QString serviceName,
                                                                                QString path,
                                                                                QString interface,
                                                                                QString getMethodName,
@@ -47,8 +53,9 @@ ADTModelBuilderStrategyDbusInfoDesktop::ADTModelBuilderStrategyDbusInfoDesktop(Q
     , m_reportMethodName(reportMethodName)
     , m_treeModelBuilder(builder)
     , m_implementedInterfacesPath()
-    , m_dbus(new QDBusConnection(QDBusConnection::systemBus()))
-    , m_dbusInterface(new QDBusInterface(m_serviceName, m_path, m_interface, *m_dbus.get()))
+    , m_dbus(new QDBusConnection(conn))
+    , m_catalogCache(nullptr)
+    , m_lazyTests(false)
 {}
 
 std::unique_ptr<TreeModel> ADTModelBuilderStrategyDbusInfoDesktop::buildModel()
@@ -62,83 +69,280 @@ std::unique_ptr<TreeModel> ADTModelBuilderStrategyDbusInfoDesktop::buildModel()
         return std::unique_ptr<TreeModel>(new TreeModel());
     }
 
-    std::vector<std::unique_ptr<ADTExecutable>> adtExecutables;
+    if (m_lazyTests)
+    {
+        return buildLazyModel(listOfObjects);
+    }
+
+    return m_treeModelBuilder->buildModel(buildExecutables(listOfObjects));
+}
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTModelBuilderStrategyDbusInfoDesktop::buildExecutables(
+    QStringList listOfObjects)
+{
+    // NOTE: all calls are sent before waiting for any reply, so discovery takes about one round trip
+    std::vector<QDBusPendingCall> listCalls;
+    std::vector<QDBusPendingCall> infoCalls;
+
+    for (const QString &currentPath : listOfObjects)
+    {
+        listCalls.push_back(callObjectMethod(currentPath, ADTModelBuilderStrategyDbusInfoDesktop::LIST_METHOD));
+        infoCalls.push_back(callObjectMethod(currentPath, ADTModelBuilderStrategyDbusInfoDesktop::INFO_METHOD));
+    }
+
+    std::vector<std::vector<std::unique_ptr<ADTExecutable>>> objectExecutables(listOfObjects.size());
+    std::vector<QString> objectKeys(listOfObjects.size());
+
+    QThreadPool pool;
+    QThread *thread = QThread::currentThread();
 
-    for (QString currentPath : listOfObjects)
+    for (int i = 0; i < listOfObjects.size(); i++)
     {
-        std::vector<std::unique_ptr<ADTExecutable>> currentExecutables = buildADTExecutablesFromDesktopFile(currentPath);
-        if (!currentExecutables.empty())
+        if (thread->isInterruptionRequested())
+        {
+            break;
+        }
+
+        QString currentPath = listOfObjects.at(i);
+
+        QDBusPendingReply<QStringList> testsListReply = listCalls[i];
+        testsListReply.waitForFinished();
+
+        if (!testsListReply.isValid())
+        {
+            qWarning() << "ERROR! Can't answer from list method from object with path: " << currentPath;
+            continue;
+        }
+
+        QStringList testsList = testsListReply.value();
+
+        for (QString &currentTestName : testsList)
+        {
+            currentTestName = currentTestName.trimmed();
+        }
+
+        if (testsList.isEmpty())
+        {
+            qWarning() << "ERROR! Can't get list of tests from object with path: " << currentPath;
+            continue;
+        }
+
+        QDBusPendingReply<QByteArray> reply = infoCalls[i];
+        reply.waitForFinished();
+
+        if (!reply.isValid())
+        {
+            qWarning() << "ERROR! Can't answer from info method from object with path: " << currentPath;
+            continue;
+        }
+
+        if (reply.value().isEmpty())
         {
-            for (auto &currentExe : currentExecutables)
+            qWarning() << "ERROR! Can't get info from object with path: " << currentPath;
+            continue;
+        }
+
+        QByteArray info = reply.value();
+
+        if (m_catalogCache)
+        {
+            objectKeys[i] = ADTCatalogCache::getKey(testsList, info);
+
+            // NOTE: the desktop file isn't parsed again while the replies are the same
+            objectExecutables[i] = m_catalogCache->find(currentPath, objectKeys[i]);
+
+            if (!objectExecutables[i].empty())
+            {
+                continue;
+            }
+        }
+
+        // NOTE: each job writes only its own element of the vector
+        std::vector<std::unique_ptr<ADTExecutable>> *result = &objectExecutables[i];
+
+        pool.start([this, result, currentPath, testsList, info, thread]() {
+            *result = buildADTExecutablesFromDesktopFile(currentPath, testsList, info, thread);
+        });
+    }
+
+    pool.waitForDone();
+
+    // NOTE: the cache keeps only discovered objects, so a partial discovery would drop the others from it
+    if (m_catalogCache && !thread->isInterruptionRequested())
+    {
+        QStringList cachedPaths;
+
+        for (int i = 0; i < listOfObjects.size(); i++)
+        {
+            if (!objectExecutables[i].empty())
             {
-                adtExecutables.push_back(std::move(currentExe));
+                m_catalogCache->setObject(listOfObjects.at(i), objectKeys[i], objectExecutables[i]);
+                cachedPaths.append(listOfObjects.at(i));
             }
         }
+
+        m_catalogCache->save(cachedPaths);
     }
 
-    return m_treeModelBuilder->buildModel(std::move(adtExecutables));
+    std::vector<std::unique_ptr<ADTExecutable>> adtExecutables;
+
+    for (auto &currentExecutables : objectExecutables)
+    {
+        for (auto &currentExe : currentExecutables)
+        {
+            adtExecutables.push_back(std::move(currentExe));
+        }
+    }
+
+    return adtExecutables;
 }
 
-QStringList ADTModelBuilderStrategyDbusInfoDesktop::getObjectsPathByInterface(QString interface)
+void ADTModelBuilderStrategyDbusInfoDesktop::setCatalogCache(ADTCatalogCache *cache)
 {
-    QDBusReply<QList<QDBusObjectPath>> reply = m_dbusInterface->call(m_get_method_name, interface);
+    m_catalogCache = cache;
+}
 
-    QList<QDBusObjectPath> pathList = reply.value();
+void ADTModelBuilderStrategyDbusInfoDesktop::setLazyTests(bool lazy)
+{
+    m_lazyTests = lazy;
+}
 
-    QStringList paths;
+std::unique_ptr<TreeModel> ADTModelBuilderStrategyDbusInfoDesktop::buildLazyModel(QStringList listOfObjects)
+{
+    std::vector<QDBusPendingCall> infoCalls;
 
-    std::for_each(pathList.begin(), pathList.end(), [&paths](QDBusObjectPath &path) { paths.append(path.path()); });
+    for (const QString &currentPath : listOfObjects)
+    {
+        infoCalls.push_back(callObjectMethod(currentPath, ADTModelBuilderStrategyDbusInfoDesktop::INFO_METHOD));
+    }
 
-    return paths;
+    std::vector<std::unique_ptr<ADTExecutable>> tools;
+    QMap<QString, QByteArray> infos;
+    QThread *thread = QThread::currentThread();
+
+    for (int i = 0; i < listOfObjects.size(); i++)
+    {
+        QString currentPath = listOfObjects.at(i);
+
+        QDBusPendingReply<QByteArray> reply = infoCalls[i];
+        reply.waitForFinished();
+
+        if (!reply.isValid())
+        {
+            qWarning() << "ERROR! Can't answer from info method from object with path: " << currentPath;
+            continue;
+        }
+
+        if (reply.value().isEmpty())
+        {
+            qWarning() << "ERROR! Can't get info from object with path: " << currentPath;
+            continue;
+        }
+
+        QByteArray info = reply.value();
+
+        // NOTE: without a list of tests only the tool section of the desktop file is parsed
+        std::vector<std::unique_ptr<ADTExecutable>> executables = buildADTExecutablesFromDesktopFile(currentPath,
+                                                                                                     QStringList(),
+                                                                                                     info,
+                                                                                                     thread);
+
+        if (executables.empty())
+        {
+            continue;
+        }
+
+        infos[currentPath] = info;
+        tools.push_back(std::move(executables.front()));
+    }
+
+    std::unique_ptr<TreeModel> model = m_treeModelBuilder->buildModel(std::move(tools));
+
+    QDBusConnection conn = *m_dbus;
+
+    model->setTestsFetcher(
+        [conn, infos](ADTExecutable *tool) { return fetchTests(conn, tool, infos.value(tool->m_dbusPath)); });
+
+    return model;
 }
 
-std::vector<std::unique_ptr<ADTExecutable>> ADTModelBuilderStrategyDbusInfoDesktop::buildADTExecutablesFromDesktopFile(
-    QString path)
+std::vector<std::unique_ptr<ADTExecutable>> ADTModelBuilderStrategyDbusInfoDesktop::fetchTests(QDBusConnection conn,
+                                                                                               ADTExecutable *tool,
+                                                                                               QByteArray info)
 {
-    QDBusInterface iface(m_serviceName, path, m_findInterface, *m_dbus.get());
+    std::vector<std::unique_ptr<ADTExecutable>> tests;
 
-    QDBusReply<QStringList> testsListReply = iface.call(ADTModelBuilderStrategyDbusInfoDesktop::LIST_METHOD);
+    QDBusMessage message = QDBusMessage::createMethodCall(tool->m_dbusServiceName,
+                                                          tool->m_dbusPath,
+                                                          tool->m_dbusInterfaceName,
+                                                          ADTModelBuilderStrategyDbusInfoDesktop::LIST_METHOD);
 
-    if (!testsListReply.isValid())
-    {
-        qWarning() << "ERROR! Can't answer from list method from object with path: " << path;
+    QDBusReply<QStringList> reply = conn.call(message);
 
-        return std::vector<std::unique_ptr<ADTExecutable>>();
+    if (!reply.isValid())
+    {
+        qWarning() << "ERROR! Can't answer from list method from object with path: " << tool->m_dbusPath;
+        return tests;
     }
 
-    QStringList testsList = testsListReply.value();
+    QStringList testsList = reply.value();
 
     for (QString &currentTestName : testsList)
     {
         currentTestName = currentTestName.trimmed();
     }
 
-    if (testsList.isEmpty())
+    ADTDesktopFileParser parser(QString(info),
+                                testsList,
+                                tool->m_dbusServiceName,
+                                tool->m_dbusPath,
+                                tool->m_dbusInterfaceName,
+                                tool->m_dbusInfoMethodName,
+                                tool->m_dbusRunMethodName,
+                                tool->m_dbusReportMethodName);
+
+    std::vector<std::unique_ptr<ADTExecutable>> executables = parser.buildExecutables();
+
+    for (auto &executable : executables)
     {
-        qWarning() << "ERROR! Can't get list of tests from object with path: " << path;
+        executable->m_infoHash = tool->m_infoHash;
+    }
 
-        return std::vector<std::unique_ptr<ADTExecutable>>();
+    // NOTE: the first executable is the tool itself, it is already in the model
+    for (size_t i = 1; i < executables.size(); i++)
+    {
+        tests.push_back(std::move(executables[i]));
     }
 
-    QDBusReply<QByteArray> reply = iface.call(ADTModelBuilderStrategyDbusInfoDesktop::INFO_METHOD);
+    return tests;
+}
 
-    if (!reply.isValid())
-    {
-        qWarning() << "ERROR! Can't answer from info method from object with path: " << path;
+QStringList ADTModelBuilderStrategyDbusInfoDesktop::getObjectsPathByInterface(QString interface)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(m_serviceName, m_path, m_interface, m_get_method_name);
+    message << interface;
 
-        return std::vector<std::unique_ptr<ADTExecutable>>();
-    }
+    // NOTE: the method is called directly, without introspection of the object
+    QDBusReply<QList<QDBusObjectPath>> reply = m_dbus->call(message);
 
-    if (reply.value().isEmpty())
-    {
-        qWarning() << "ERROR! Can't get info from object with path: " << path;
+    QList<QDBusObjectPath> pathList = reply.value();
 
-        return std::vector<std::unique_ptr<ADTExecutable>>();
-    }
+    QStringList paths;
 
-    QString info(reply.value());
+    std::for_each(pathList.begin(), pathList.end(), [&paths](QDBusObjectPath &path) { paths.append(path.path()); });
+
+    return paths;
+}
 
-    ADTDesktopFileParser parser(info,
+QDBusPendingCall ADTModelBuilderStrategyDbusInfoDesktop::callObjectMethod(QString path, QString method)
+{
+    return m_dbus->asyncCall(QDBusMessage::createMethodCall(m_serviceName, path, m_findInterface, method));
+}
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTModelBuilderStrategyDbusInfoDesktop::buildADTExecutablesFromDesktopFile(
+    QString path, QStringList testsList, QByteArray info, QThread *thread)
+{
+    ADTDesktopFileParser parser(QString(info),
                                 testsList,
                                 m_serviceName,
                                 path,
@@ -147,5 +351,17 @@ std::vector<std::unique_ptr<ADTExecutable>> ADTModelBuilderStrategyDbusInfoDeskt
                                 m_runMethodName,
                                 m_reportMethodName);
 
-    return parser.buildExecutables();
+    std::vector<std::unique_ptr<ADTExecutable>> executables = parser.buildExecutables();
+
+    QString infoHash = QCryptographicHash::hash(info, QCryptographicHash::Sha1).toHex();
+
+    for (auto &executable : executables)
+    {
+        executable->m_infoHash = infoHash;
+
+        // NOTE: the executable is created in a thread of the pool, its queued calls must reach the caller's thread
+        executable->moveToThread(thread);
+    }
+
+    return executables;
 }
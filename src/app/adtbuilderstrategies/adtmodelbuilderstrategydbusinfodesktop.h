@@ -1,12 +1,14 @@
 #ifndef ADTMODELBUILDERSTRATEGYDBUSINFODESKTOP_H
 #define ADTMODELBUILDERSTRATEGYDBUSINFODESKTOP_H
 
+#include "adtcatalogcache.h"
 #include "../core/treemodelbuilderinterface.h"
 #include "adtmodelbuilderstrategyinterface.h"
 
 #include <QDBusConnection>
-#include <QDBusInterface>
+#include <QDBusPendingCall>
 #include <QString>
+#include <QThread>
 
 class ADTModelBuilderStrategyDbusInfoDesktop : public ADTModelBuilderStrategyInterface
 {
@@ -14,7 +16,8 @@ public:
     static const QString LIST_METHOD;
     static const QString INFO_METHOD;
 
-    ADTModelBuilderStrategyDbusInfoDesktop(QString serviceName,
+    ADTModelBuilderStrategyDbusInfoDesktop(QDBusConnection conn,
+                                           QString serviceName,
                                            QString path,
                                            QString interface,
                                            QString getMethodName,
@@ -27,10 +30,33 @@ public:
 public:
     std::unique_ptr<TreeModel> buildModel() override;
 
+    // Executables are moved to the thread, the method may be called from any thread
+    std::vector<std::unique_ptr<ADTExecutable>> buildADTExecutablesFromDesktopFile(QString path,
+                                                                                   QStringList testsList,
+                                                                                   QByteArray info,
+                                                                                   QThread *thread);
+
+    // Objects with unchanged List and Info replies are taken from the cache, the cache is updated after discovery
+    void setCatalogCache(ADTCatalogCache *cache);
+
+    // Only tools are discovered, tests of each tool are fetched by the model when they are requested.
+    // NOTE: the catalog cache isn't used in this mode, it is written only after a complete discovery
+    void setLazyTests(bool lazy);
+
 private:
+    std::unique_ptr<TreeModel> buildLazyModel(QStringList listOfObjects);
+
+    static std::vector<std::unique_ptr<ADTExecutable>> fetchTests(QDBusConnection conn,
+                                                                  ADTExecutable *tool,
+                                                                  QByteArray info);
+
     QStringList getObjectsPathByInterface(QString interface);
 
-    std::vector<std::unique_ptr<ADTExecutable>> buildADTExecutablesFromDesktopFile(QString path);
+    QDBusPendingCall callObjectMethod(QString path, QString method);
+
+    // Builds tools and tests of the objects. If the catalog cache is set, only these objects are kept in it.
+    // Discovery stops when interruption of the current thread is requested, the cache isn't changed then
+    std::vector<std::unique_ptr<ADTExecutable>> buildExecutables(QStringList listOfObjects);
 
 private:
     QString m_serviceName;
@@ -47,7 +73,10 @@ private:
     QList<QString> m_implementedInterfacesPath;
 
     std::unique_ptr<QDBusConnection> m_dbus;
-    std::unique_ptr<QDBusInterface> m_dbusInterface;
+
+    ADTCatalogCache *m_catalogCache;
+
+    bool m_lazyTests;
 };
 
 #endif // ADTMODELBUILDERSTRATEGYDBUSINFODESKTOP_H
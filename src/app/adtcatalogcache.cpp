@@ -0,0 +1,332 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtcatalogcache.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QSaveFile>
+
+// NOTE: increment when the stored fields are changed, older caches are dropped.
+// Version 1 caches could be written with only the tools fetched by a lazy model
+const int CATALOG_VERSION = 2;
+
+const char *const CATALOG_VERSION_KEY = "version";
+const char *const CATALOG_OBJECTS_KEY = "objects";
+const char *const OBJECT_PATH_KEY     = "path";
+const char *const OBJECT_KEY_KEY      = "key";
+const char *const OBJECT_TESTS_KEY    = "executables";
+
+const char *const ID_KEY                  = "id";
+const char *const TYPE_KEY                = "type";
+const char *const NAME_KEY                = "name";
+const char *const TOOL_ID_KEY             = "toolId";
+const char *const REPORT_SUFFIX_KEY       = "reportSuffix";
+const char *const ICON_KEY                = "icon";
+const char *const DESCRIPTION_KEY         = "description";
+const char *const ARGS_KEY                = "args";
+const char *const SERVICE_NAME_KEY        = "dbusServiceName";
+const char *const PATH_KEY                = "dbusPath";
+const char *const INTERFACE_NAME_KEY      = "dbusInterfaceName";
+const char *const INFO_METHOD_NAME_KEY    = "dbusInfoMethodName";
+const char *const RUN_METHOD_NAME_KEY     = "dbusRunMethodName";
+const char *const REPORT_METHOD_NAME_KEY  = "dbusReportMethodName";
+const char *const INFO_HASH_KEY           = "infoHash";
+const char *const NAME_LOCALES_KEY        = "nameLocales";
+const char *const DESCRIPTION_LOCALES_KEY = "descriptionLocales";
+
+class ADTCatalogCachePrivate
+{
+public:
+    ADTCatalogCachePrivate(QString fileName)
+        : m_fileName(fileName)
+        , m_paths()
+        , m_objects()
+    {}
+
+    ~ADTCatalogCachePrivate() = default;
+
+    QString m_fileName;
+
+    // Paths of objects in the order of discovery and their entries
+    QStringList m_paths;
+    QMap<QString, QJsonObject> m_objects;
+
+private:
+    ADTCatalogCachePrivate(const ADTCatalogCachePrivate &) = delete;
+    ADTCatalogCachePrivate(ADTCatalogCachePrivate &&)      = delete;
+    ADTCatalogCachePrivate &operator=(const ADTCatalogCachePrivate &) = delete;
+    ADTCatalogCachePrivate &operator=(ADTCatalogCachePrivate &&) = delete;
+};
+
+ADTCatalogCache::ADTCatalogCache(QString fileName)
+    : d(std::make_unique<ADTCatalogCachePrivate>(fileName))
+{
+    load();
+}
+
+ADTCatalogCache::~ADTCatalogCache() {}
+
+bool ADTCatalogCache::isEmpty()
+{
+    return d->m_paths.isEmpty();
+}
+
+QStringList ADTCatalogCache::getPaths()
+{
+    return d->m_paths;
+}
+
+QMap<QString, QString> ADTCatalogCache::getKeys()
+{
+    QMap<QString, QString> keys;
+
+    for (auto it = d->m_objects.begin(); it != d->m_objects.end(); ++it)
+    {
+        keys[it.key()] = it->value(OBJECT_KEY_KEY).toString();
+    }
+
+    return keys;
+}
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTCatalogCache::getExecutables()
+{
+    std::vector<std::unique_ptr<ADTExecutable>> executables;
+
+    for (const QString &path : d->m_paths)
+    {
+        for (const QJsonValue &value : d->m_objects[path].value(OBJECT_TESTS_KEY).toArray())
+        {
+            executables.push_back(executableFromJson(value.toObject()));
+        }
+    }
+
+    return executables;
+}
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTCatalogCache::find(QString path, QString key)
+{
+    std::vector<std::unique_ptr<ADTExecutable>> executables;
+
+    auto it = d->m_objects.find(path);
+
+    if (it == d->m_objects.end() || it->value(OBJECT_KEY_KEY).toString() != key)
+    {
+        return executables;
+    }
+
+    for (const QJsonValue &value : it->value(OBJECT_TESTS_KEY).toArray())
+    {
+        executables.push_back(executableFromJson(value.toObject()));
+    }
+
+    return executables;
+}
+
+void ADTCatalogCache::setObject(QString path,
+                                QString key,
+                                const std::vector<std::unique_ptr<ADTExecutable>> &executables)
+{
+    QJsonArray tests;
+
+    for (const auto &executable : executables)
+    {
+        tests.append(executableToJson(executable.get()));
+    }
+
+    QJsonObject object;
+    object[OBJECT_PATH_KEY]  = path;
+    object[OBJECT_KEY_KEY]   = key;
+    object[OBJECT_TESTS_KEY] = tests;
+
+    d->m_objects[path] = object;
+}
+
+bool ADTCatalogCache::save(QStringList paths)
+{
+    QJsonArray objects;
+    QMap<QString, QJsonObject> savedObjects;
+
+    for (const QString &path : paths)
+    {
+        auto it = d->m_objects.find(path);
+
+        if (it == d->m_objects.end())
+        {
+            continue;
+        }
+
+        objects.append(*it);
+        savedObjects[path] = *it;
+    }
+
+    bool isChanged = paths != d->m_paths || savedObjects != d->m_objects;
+
+    d->m_paths   = paths;
+    d->m_objects = savedObjects;
+
+    if (!isChanged)
+    {
+        return false;
+    }
+
+    QJsonObject catalog;
+    catalog[CATALOG_VERSION_KEY] = CATALOG_VERSION;
+    catalog[CATALOG_OBJECTS_KEY] = objects;
+
+    QDir().mkpath(QFileInfo(d->m_fileName).absolutePath());
+
+    QSaveFile catalogFile(d->m_fileName);
+
+    if (!catalogFile.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "WARNING! Can't write catalog cache: " << d->m_fileName;
+        return true;
+    }
+
+    catalogFile.write(QJsonDocument(catalog).toJson(QJsonDocument::Compact));
+    catalogFile.commit();
+
+    return true;
+}
+
+QString ADTCatalogCache::getKey(QStringList tests, QByteArray info)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    hash.addData(tests.join('\n').toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(info);
+
+    return hash.result().toHex();
+}
+
+void ADTCatalogCache::load()
+{
+    QFile catalogFile(d->m_fileName);
+
+    if (!catalogFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QJsonObject catalog = QJsonDocument::fromJson(catalogFile.readAll()).object();
+
+    if (catalog.value(CATALOG_VERSION_KEY).toInt() != CATALOG_VERSION)
+    {
+        return;
+    }
+
+    for (const QJsonValue &value : catalog.value(CATALOG_OBJECTS_KEY).toArray())
+    {
+        QJsonObject object = value.toObject();
+        QString path       = object.value(OBJECT_PATH_KEY).toString();
+
+        if (path.isEmpty() || d->m_objects.contains(path))
+        {
+            continue;
+        }
+
+        d->m_paths.append(path);
+        d->m_objects[path] = object;
+    }
+}
+
+QJsonObject ADTCatalogCache::executableToJson(ADTExecutable *executable)
+{
+    QJsonObject nameLocales;
+    QJsonObject descriptionLocales;
+
+    for (auto it = executable->m_nameLocaleStorage.begin(); it != executable->m_nameLocaleStorage.end(); ++it)
+    {
+        nameLocales[it.key()] = it.value();
+    }
+
+    for (auto it = executable->m_descriptionLocaleStorage.begin(); it != executable->m_descriptionLocaleStorage.end();
+         ++it)
+    {
+        descriptionLocales[it.key()] = it.value();
+    }
+
+    QJsonObject json;
+    json[ID_KEY]                  = executable->m_id;
+    json[TYPE_KEY]                = executable->m_type;
+    json[NAME_KEY]                = executable->m_name;
+    json[TOOL_ID_KEY]             = executable->m_toolId;
+    json[REPORT_SUFFIX_KEY]       = executable->m_reportSuffix;
+    json[ICON_KEY]                = executable->m_icon;
+    json[DESCRIPTION_KEY]         = executable->m_description;
+    json[ARGS_KEY]                = executable->m_args;
+    json[SERVICE_NAME_KEY]        = executable->m_dbusServiceName;
+    json[PATH_KEY]                = executable->m_dbusPath;
+    json[INTERFACE_NAME_KEY]      = executable->m_dbusInterfaceName;
+    json[INFO_METHOD_NAME_KEY]    = executable->m_dbusInfoMethodName;
+    json[RUN_METHOD_NAME_KEY]     = executable->m_dbusRunMethodName;
+    json[REPORT_METHOD_NAME_KEY]  = executable->m_dbusReportMethodName;
+    json[INFO_HASH_KEY]           = executable->m_infoHash;
+    json[NAME_LOCALES_KEY]        = nameLocales;
+    json[DESCRIPTION_LOCALES_KEY] = descriptionLocales;
+
+    return json;
+}
+
+std::unique_ptr<ADTExecutable> ADTCatalogCache::executableFromJson(QJsonObject json)
+{
+    std::unique_ptr<ADTExecutable> executable = std::make_unique<ADTExecutable>();
+
+    executable->m_id                   = json.value(ID_KEY).toString();
+    executable->m_type                 = json.value(TYPE_KEY).toInt(-1);
+    executable->m_name                 = json.value(NAME_KEY).toString();
+    executable->m_toolId               = json.value(TOOL_ID_KEY).toString();
+    executable->m_reportSuffix         = json.value(REPORT_SUFFIX_KEY).toString();
+    executable->m_icon                 = json.value(ICON_KEY).toString();
+    executable->m_description          = json.value(DESCRIPTION_KEY).toString();
+    executable->m_args                 = json.value(ARGS_KEY).toString();
+    executable->m_dbusServiceName      = json.value(SERVICE_NAME_KEY).toString();
+    executable->m_dbusPath             = json.value(PATH_KEY).toString();
+    executable->m_dbusInterfaceName    = json.value(INTERFACE_NAME_KEY).toString();
+    executable->m_dbusInfoMethodName   = json.value(INFO_METHOD_NAME_KEY).toString();
+    executable->m_dbusRunMethodName    = json.value(RUN_METHOD_NAME_KEY).toString();
+    executable->m_dbusReportMethodName = json.value(REPORT_METHOD_NAME_KEY).toString();
+    executable->m_infoHash             = json.value(INFO_HASH_KEY).toString();
+
+    QJsonObject nameLocales = json.value(NAME_LOCALES_KEY).toObject();
+
+    for (auto it = nameLocales.begin(); it != nameLocales.end(); ++it)
+    {
+        executable->m_nameLocaleStorage[it.key()] = it.value().toString();
+    }
+
+    QJsonObject descriptionLocales = json.value(DESCRIPTION_LOCALES_KEY).toObject();
+
+    for (auto it = descriptionLocales.begin(); it != descriptionLocales.end(); ++it)
+    {
+        executable->m_descriptionLocaleStorage[it.key()] = it.value().toString();
+    }
+
+    return executable;
+}
@@ -0,0 +1,85 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTCATALOGCACHE_H
+#define ADTCATALOGCACHE_H
+
+#include "../core/adtexecutable.h"
+
+#include <memory>
+#include <vector>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+class ADTCatalogCachePrivate;
+
+/*
+ * Keeps parsed executables of each discovered object on disk, so the catalog
+ * is shown at startup without D-Bus calls and desktop files are parsed only when they change.
+ * An object is keyed by a hash of its List result and its Info payload.
+ */
+class ADTCatalogCache
+{
+public:
+    ADTCatalogCache(QString fileName);
+    ~ADTCatalogCache();
+
+    bool isEmpty();
+
+    // Paths of cached objects in the order of the last discovery
+    QStringList getPaths();
+
+    // Catalog keys of cached objects by their paths
+    QMap<QString, QString> getKeys();
+
+    // Executables of all cached objects in the order of the last discovery
+    std::vector<std::unique_ptr<ADTExecutable>> getExecutables();
+
+    // Returns executables of the object if they were cached with the same key, otherwise nothing
+    std::vector<std::unique_ptr<ADTExecutable>> find(QString path, QString key);
+
+    void setObject(QString path, QString key, const std::vector<std::unique_ptr<ADTExecutable>> &executables);
+
+    // Drops objects which are not in the list and writes the cache, returns true if the catalog was changed.
+    // NOTE: the list must be the result of a complete discovery, a non-empty cache is taken as the whole catalog
+    bool save(QStringList paths);
+
+    static QString getKey(QStringList tests, QByteArray info);
+
+private:
+    void load();
+
+    static QJsonObject executableToJson(ADTExecutable *executable);
+    static std::unique_ptr<ADTExecutable> executableFromJson(QJsonObject json);
+
+private:
+    std::unique_ptr<ADTCatalogCachePrivate> d;
+
+private:
+    ADTCatalogCache(const ADTCatalogCache &) = delete;
+    ADTCatalogCache(ADTCatalogCache &&)      = delete;
+    ADTCatalogCache &operator=(const ADTCatalogCache &) = delete;
+    ADTCatalogCache &operator=(ADTCatalogCache &&) = delete;
+};
+
+#endif // ADTCATALOGCACHE_H
@@ -0,0 +1,292 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtcatalogwatcher.h"
+#include "../core/treemodelbulderfromexecutable.h"
+#include "adtbuilderstrategies/adtmodelbuilderstrategydbusinfodesktop.h"
+
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingCall>
+#include <QDBusPendingReply>
+#include <QDBusReply>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+
+const int ADTCatalogWatcher::POLL_INTERVAL = 10000;
+
+class ADTCatalogWatcherPoll
+{
+public:
+    ADTCatalogWatcherPoll()
+        : m_previousPaths()
+        , m_isBaseline(true)
+        , m_isValid(false)
+        , m_paths()
+        , m_removed()
+        , m_executables()
+    {}
+
+    ~ADTCatalogWatcherPoll() = default;
+
+    // Paths of the objects after the previous poll
+    QSet<QString> m_previousPaths;
+    bool m_isBaseline;
+
+    bool m_isValid;
+    QSet<QString> m_paths;
+    QStringList m_removed;
+    std::vector<std::unique_ptr<ADTExecutable>> m_executables;
+
+private:
+    ADTCatalogWatcherPoll(const ADTCatalogWatcherPoll &) = delete;
+    ADTCatalogWatcherPoll(ADTCatalogWatcherPoll &&)      = delete;
+    ADTCatalogWatcherPoll &operator=(const ADTCatalogWatcherPoll &) = delete;
+    ADTCatalogWatcherPoll &operator=(ADTCatalogWatcherPoll &&) = delete;
+};
+
+class ADTCatalogWatcherPrivate
+{
+public:
+    ADTCatalogWatcherPrivate(QDBusConnection conn, InterfaceData ifaceData)
+        : m_dbus(conn)
+        , m_interfaceData(ifaceData)
+        , m_timer()
+        , m_thread(nullptr)
+        , m_paths()
+        , m_isSeeded(false)
+        , m_executables()
+    {}
+
+    ~ADTCatalogWatcherPrivate() = default;
+
+    QDBusConnection m_dbus;
+
+    InterfaceData m_interfaceData;
+
+    QTimer m_timer;
+
+    QThread *m_thread;
+
+    // Paths of the objects after the previous poll
+    QSet<QString> m_paths;
+    bool m_isSeeded;
+
+    std::vector<std::unique_ptr<ADTExecutable>> m_executables;
+
+private:
+    ADTCatalogWatcherPrivate(const ADTCatalogWatcherPrivate &) = delete;
+    ADTCatalogWatcherPrivate(ADTCatalogWatcherPrivate &&)      = delete;
+    ADTCatalogWatcherPrivate &operator=(const ADTCatalogWatcherPrivate &) = delete;
+    ADTCatalogWatcherPrivate &operator=(ADTCatalogWatcherPrivate &&) = delete;
+};
+
+ADTCatalogWatcher::ADTCatalogWatcher(QDBusConnection conn, InterfaceData ifaceData)
+    : d(std::make_unique<ADTCatalogWatcherPrivate>(conn, ifaceData))
+{
+    connect(&d->m_timer, &QTimer::timeout, this, &ADTCatalogWatcher::check);
+
+    d->m_timer.start(POLL_INTERVAL);
+
+    check();
+}
+
+ADTCatalogWatcher::~ADTCatalogWatcher()
+{
+    if (d->m_thread)
+    {
+        d->m_thread->requestInterruption();
+        d->m_thread->wait();
+        delete d->m_thread;
+    }
+}
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTCatalogWatcher::takeExecutables()
+{
+    std::vector<std::unique_ptr<ADTExecutable>> executables = std::move(d->m_executables);
+
+    d->m_executables.clear();
+
+    return executables;
+}
+
+void ADTCatalogWatcher::check()
+{
+    if (d->m_thread)
+    {
+        return;
+    }
+
+    std::shared_ptr<ADTCatalogWatcherPoll> result = std::make_shared<ADTCatalogWatcherPoll>();
+    result->m_previousPaths                       = d->m_paths;
+    result->m_isBaseline                          = !d->m_isSeeded;
+
+    QDBusConnection conn    = d->m_dbus;
+    InterfaceData ifaceData = d->m_interfaceData;
+    QThread *ownThread      = thread();
+
+    d->m_thread = QThread::create([this, result, conn, ifaceData, ownThread]() {
+        poll(result.get(), conn, ifaceData, ownThread);
+
+        // NOTE: the result is applied in the thread of the watcher, the call is dropped if the watcher is deleted
+        QMetaObject::invokeMethod(
+            this, [this, result]() { onPollFinished(result); }, Qt::QueuedConnection);
+    });
+
+    d->m_thread->start(QThread::LowPriority);
+}
+
+void ADTCatalogWatcher::onPollFinished(std::shared_ptr<ADTCatalogWatcherPoll> result)
+{
+    d->m_thread->wait();
+    delete d->m_thread;
+    d->m_thread = nullptr;
+
+    if (!result->m_isValid)
+    {
+        return;
+    }
+
+    d->m_paths    = result->m_paths;
+    d->m_isSeeded = true;
+
+    if (result->m_removed.isEmpty() && result->m_executables.empty())
+    {
+        return;
+    }
+
+    for (auto &executable : result->m_executables)
+    {
+        d->m_executables.push_back(std::move(executable));
+    }
+
+    emit objectsChanged(result->m_removed);
+}
+
+void ADTCatalogWatcher::poll(ADTCatalogWatcherPoll *result,
+                             QDBusConnection conn,
+                             InterfaceData ifaceData,
+                             QThread *thread)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(ifaceData.serviceName,
+                                                          ifaceData.path,
+                                                          ifaceData.managerInterface,
+                                                          ifaceData.managerGetMethod);
+    message << ifaceData.ifaceName;
+
+    QDBusReply<QList<QDBusObjectPath>> reply = conn.call(message);
+
+    // NOTE: the manager may be restarting, the next poll asks again
+    if (!reply.isValid())
+    {
+        return;
+    }
+
+    QStringList added;
+
+    for (const QDBusObjectPath &path : reply.value())
+    {
+        result->m_paths.insert(path.path());
+
+        if (!result->m_isBaseline && !result->m_previousPaths.contains(path.path()))
+        {
+            added.append(path.path());
+        }
+    }
+
+    // NOTE: removed objects are dropped without any calls
+    if (!result->m_isBaseline)
+    {
+        for (const QString &previousPath : result->m_previousPaths)
+        {
+            if (!result->m_paths.contains(previousPath))
+            {
+                result->m_removed.append(previousPath);
+            }
+        }
+    }
+
+    // NOTE: only added objects are asked for List and Info, all calls are sent before waiting for any reply
+    std::vector<QDBusPendingCall> listCalls;
+    std::vector<QDBusPendingCall> infoCalls;
+
+    for (const QString &currentPath : added)
+    {
+        listCalls.push_back(conn.asyncCall(
+            QDBusMessage::createMethodCall(ifaceData.serviceName,
+                                           currentPath,
+                                           ifaceData.ifaceName,
+                                           ADTModelBuilderStrategyDbusInfoDesktop::LIST_METHOD)));
+        infoCalls.push_back(conn.asyncCall(
+            QDBusMessage::createMethodCall(ifaceData.serviceName,
+                                           currentPath,
+                                           ifaceData.ifaceName,
+                                           ADTModelBuilderStrategyDbusInfoDesktop::INFO_METHOD)));
+    }
+
+    ADTModelBuilderStrategyDbusInfoDesktop parser(conn,
+                                                  ifaceData.serviceName,
+                                                  ifaceData.path,
+                                                  ifaceData.managerInterface,
+                                                  ifaceData.managerGetMethod,
+                                                  ifaceData.ifaceName,
+                                                  ifaceData.infoMethodName,
+                                                  ifaceData.runMethodName,
+                                                  ifaceData.reportMethodName,
+                                                  new TreeModelBulderFromExecutable());
+
+    for (int i = 0; i < added.size(); i++)
+    {
+        if (QThread::currentThread()->isInterruptionRequested())
+        {
+            return;
+        }
+
+        QString currentPath = added.at(i);
+
+        QDBusPendingReply<QStringList> listReply = listCalls[i];
+        listReply.waitForFinished();
+
+        QDBusPendingReply<QByteArray> infoReply = infoCalls[i];
+        infoReply.waitForFinished();
+
+        QStringList testsList = listReply.isValid() ? listReply.value() : QStringList();
+        QByteArray info       = infoReply.isValid() ? infoReply.value() : QByteArray();
+
+        for (QString &currentTestName : testsList)
+        {
+            currentTestName = currentTestName.trimmed();
+        }
+
+        // NOTE: an object which fails discovery isn't asked again until it is registered again
+        if (testsList.isEmpty() || info.isEmpty())
+        {
+            continue;
+        }
+
+        for (auto &executable : parser.buildADTExecutablesFromDesktopFile(currentPath, testsList, info, thread))
+        {
+            result->m_executables.push_back(std::move(executable));
+        }
+    }
+
+    result->m_isValid = true;
+}
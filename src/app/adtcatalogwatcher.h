@@ -0,0 +1,80 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTCATALOGWATCHER_H
+#define ADTCATALOGWATCHER_H
+
+#include "../core/adtexecutable.h"
+#include "interfacedata.h"
+
+#include <memory>
+#include <vector>
+#include <QDBusConnection>
+#include <QObject>
+#include <QStringList>
+
+class ADTCatalogWatcherPrivate;
+class ADTCatalogWatcherPoll;
+
+/*
+ * Polls the manager for D-Bus objects of tools in a worker thread. A poll asks only for the set of object
+ * paths, List and Info are called only for added objects. An object which is registered again at the
+ * same path between two polls isn't noticed, its catalog is revalidated at the next start.
+ * The first poll only sets the objects to compare with.
+ */
+class ADTCatalogWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    // Interval between polls, msec
+    static const int POLL_INTERVAL;
+
+public:
+    ADTCatalogWatcher(QDBusConnection conn, InterfaceData ifaceData);
+    ~ADTCatalogWatcher();
+
+    // Executables of objects added or changed since the previous call, they belong to the thread of the watcher
+    std::vector<std::unique_ptr<ADTExecutable>> takeExecutables();
+
+public slots:
+    // Does nothing while the previous poll isn't finished
+    void check();
+
+signals:
+    // Executables of added objects are taken with takeExecutables()
+    void objectsChanged(QStringList removed);
+
+private:
+    void onPollFinished(std::shared_ptr<ADTCatalogWatcherPoll> result);
+
+    // Runs in the worker thread
+    static void poll(ADTCatalogWatcherPoll *result, QDBusConnection conn, InterfaceData ifaceData, QThread *thread);
+
+private:
+    std::unique_ptr<ADTCatalogWatcherPrivate> d;
+
+private:
+    ADTCatalogWatcher(const ADTCatalogWatcher &) = delete;
+    ADTCatalogWatcher(ADTCatalogWatcher &&)      = delete;
+    ADTCatalogWatcher &operator=(const ADTCatalogWatcher &) = delete;
+    ADTCatalogWatcher &operator=(ADTCatalogWatcher &&) = delete;
+};
+
+#endif // ADTCATALOGWATCHER_H
@@ -19,10 +19,18 @@
 ***********************************************************************************************************************/
 
 #include "adtexecutor.h"
+#include "adtbudgetplanner.h"
+#include "adttaskqueue.h"
 
+#include <algorithm>
+#include <map>
 #include <QApplication>
 #include <QDBusConnection>
-#include <QDBusReply>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QMap>
 #include <QThread>
 #include <QTimer>
 #include <qdbusmessage.h>
@@ -30,11 +38,47 @@
 const QString STDOUT_SIGNAL_NAME = "diag1_stdout_signal";
 const QString STDERR_SIGNAL_NAME = "diag1_stderr_signal";
 
+// Interval of checking stop and wait flags while tasks are running, msec
+const int DISPATCH_INTERVAL = 100;
+
+// Interval of reporting that queued tasks are waiting for an idle host in background mode, msec
+const int IDLE_WAIT_REPORT_INTERVAL = 60000;
+
+struct ADTRunningTask
+{
+    ADTExecutable *task{nullptr};
+    QString stdoutSignal{};
+    QString stderrSignal{};
+    QElapsedTimer timer{};
+    int slot{-1};
+};
+
 class ADTExecutorPrivate
 {
 public:
     ADTExecutorPrivate()
         : executables()
+        , resultCache(nullptr)
+        , connection(QDBusConnection::systemBus())
+        , runHistory(nullptr)
+        , timeBudget(0)
+        , admissionControl(nullptr)
+        , admissionTimer()
+        , admissionWaitTime(0)
+        , idleMonitor(nullptr)
+        , idleWaitTimer()
+        , idleWaitReports(0)
+        , lineClassifier(nullptr)
+        , outputHeadLimit(0)
+        , outputTailLimit(0)
+        , outputSink(nullptr)
+        , maxConcurrentTasks(1)
+        , taskQueue()
+        , runningTasks()
+        , outputTargets()
+        , planner(nullptr)
+        , runTimer()
+        , eventLoop(nullptr)
         , stopFlag(false)
         , waitFlag(false)
         , isRunning(false)
@@ -44,6 +88,48 @@ public:
 
     std::vector<ADTExecutable *> executables;
 
+    ADTResultCache *resultCache;
+
+    QDBusConnection connection;
+
+    ADTRunHistory *runHistory;
+
+    // msec, 0 - unlimited
+    qint64 timeBudget;
+
+    ADTAdmissionControl *admissionControl;
+
+    // Started when a task has to wait for a free host slot, msec
+    QElapsedTimer admissionTimer;
+    qint64 admissionWaitTime;
+
+    ADTIdleMonitor *idleMonitor;
+
+    // Started when queued tasks have to wait for an idle host, msec
+    QElapsedTimer idleWaitTimer;
+    qint64 idleWaitReports;
+
+    ADTLineClassifier *lineClassifier;
+
+    qint64 outputHeadLimit;
+    qint64 outputTailLimit;
+
+    ADTOutputSink *outputSink;
+
+    int maxConcurrentTasks;
+
+    ADTTaskQueue taskQueue;
+
+    std::map<QDBusPendingCallWatcher *, std::unique_ptr<ADTRunningTask>> runningTasks;
+
+    // Running tasks by D-Bus object path to route output signals
+    QMap<QString, ADTExecutable *> outputTargets;
+
+    std::unique_ptr<ADTBudgetPlanner> planner;
+    QElapsedTimer runTimer;
+
+    QEventLoop *eventLoop;
+
     volatile bool stopFlag;
     volatile bool waitFlag;
     volatile bool isRunning;
@@ -101,6 +187,67 @@ void ADTExecutor::setTasks(std::vector<ADTExecutable *> &tasks)
     d->executables.assign(tasks.begin(), tasks.end());
 }
 
+void ADTExecutor::setResultCache(ADTResultCache *cache)
+{
+    d->resultCache = cache;
+}
+
+void ADTExecutor::setConnection(QDBusConnection conn)
+{
+    d->connection = conn;
+}
+
+void ADTExecutor::setRunHistory(ADTRunHistory *history)
+{
+    d->runHistory = history;
+}
+
+void ADTExecutor::setTimeBudget(qint64 budget)
+{
+    d->timeBudget = budget;
+}
+
+void ADTExecutor::setAdmissionControl(ADTAdmissionControl *admissionControl)
+{
+    d->admissionControl = admissionControl;
+}
+
+qint64 ADTExecutor::getAdmissionWaitTime()
+{
+    return d->admissionWaitTime;
+}
+
+void ADTExecutor::setIdleMonitor(ADTIdleMonitor *monitor)
+{
+    d->idleMonitor = monitor;
+}
+
+void ADTExecutor::setLineClassifier(ADTLineClassifier *classifier)
+{
+    d->lineClassifier = classifier;
+}
+
+void ADTExecutor::setOutputSink(ADTOutputSink *sink)
+{
+    d->outputSink = sink;
+}
+
+void ADTExecutor::setOutputLimits(qint64 headBytes, qint64 tailBytes)
+{
+    d->outputHeadLimit = headBytes;
+    d->outputTailLimit = tailBytes;
+}
+
+void ADTExecutor::setMaxConcurrentTasks(int count)
+{
+    d->maxConcurrentTasks = std::max(1, count);
+}
+
+void ADTExecutor::setToolWeight(QString toolId, int weight)
+{
+    d->taskQueue.setToolWeight(toolId, weight);
+}
+
 void ADTExecutor::runTasks()
 {
     emit allTaskBegin();
@@ -120,36 +267,54 @@ void ADTExecutor::runTasks()
 
     d->isRunning = true;
 
-    for (ADTExecutable *executable : d->executables)
+    d->admissionWaitTime = 0;
+    d->admissionTimer.invalidate();
+    d->idleWaitTimer.invalidate();
+
+    std::vector<ADTExecutable *> tasks = d->executables;
+
+    d->planner = std::make_unique<ADTBudgetPlanner>(d->runHistory);
+    d->runTimer.start();
+
+    if (d->timeBudget > 0)
     {
-        if (d->stopFlag)
-        {
-            break;
-        }
+        std::vector<ADTExecutable *> skippedTasks;
 
-        if (d->waitFlag)
+        tasks = d->planner->plan(d->executables, d->timeBudget, skippedTasks);
+
+        for (ADTExecutable *executable : skippedTasks)
         {
-            while (true)
-            {
-                if (d->waitFlag)
-                {
-                    QThread::currentThread()->yieldCurrentThread();
-                }
-                else
-                {
-                    break;
-                }
-            }
+            emit skipTask(executable);
         }
+    }
 
-        emit beginTask(executable);
+    d->taskQueue.setTasks(tasks, d->timeBudget > 0);
 
-        executeTask(executable);
+    dispatchTasks();
 
-        emit finishTask(executable);
+    if (hasPendingTasks())
+    {
+        QEventLoop eventLoop;
+        QTimer dispatchTimer;
+
+        connect(&dispatchTimer, &QTimer::timeout, this, &ADTExecutor::dispatchTasks);
+        dispatchTimer.start(DISPATCH_INTERVAL);
+
+        d->eventLoop = &eventLoop;
+        eventLoop.exec();
+        d->eventLoop = nullptr;
     }
+
+    d->taskQueue.clear();
+    d->planner.reset();
+
     d->isRunning = false;
 
+    if (d->runHistory)
+    {
+        d->runHistory->save();
+    }
+
     this->moveToThread(QApplication::instance()->thread());
 
     emit allTasksFinished();
@@ -157,73 +322,290 @@ void ADTExecutor::runTasks()
     QThread::currentThread()->quit();
 }
 
-void ADTExecutor::executeTask(ADTExecutable *task)
+void ADTExecutor::dispatchTasks()
 {
-    QDBusConnection dbus(QDBusConnection::systemBus());
+    if (d->stopFlag)
+    {
+        d->taskQueue.clear();
+    }
+
+    while (!d->waitFlag && static_cast<int>(d->runningTasks.size()) < d->maxConcurrentTasks)
+    {
+        // NOTE: running tests are not cancelled, new ones are started when the load drops
+        if (d->idleMonitor && !d->idleMonitor->isIdle())
+        {
+            reportIdleWait();
+            break;
+        }
+
+        d->idleWaitTimer.invalidate();
+
+        ADTExecutable *executable = d->taskQueue.takeNextTask();
+
+        if (!executable)
+        {
+            break;
+        }
+
+        // NOTE: don't start tests which are not expected to finish before the deadline
+        if (d->timeBudget > 0
+            && d->runTimer.elapsed() + d->planner->getEstimatedDuration(executable) > d->timeBudget)
+        {
+            emit skipTask(executable);
+            continue;
+        }
 
-    QDBusInterface dbusIface(task->m_dbusServiceName, task->m_dbusPath, task->m_dbusInterfaceName, dbus);
+        executable->clearReports();
+        executable->m_cached     = false;
+        executable->m_classifier = d->lineClassifier;
+
+        executable->m_outputHeadLimit = d->outputHeadLimit;
+        executable->m_outputTailLimit = d->outputTailLimit;
+
+        if (d->outputSink)
+        {
+            executable->setOutputSink(d->outputSink);
+        }
+
+        if (d->resultCache && d->resultCache->lookup(executable))
+        {
+            executable->setOutputSink(nullptr);
 
-    task->clearReports();
+            emit beginTask(executable);
+            emit finishTask(executable);
 
-    QString signalPrefix = dbus.baseService();
+            executable->m_logStore.compressInBackground();
+            continue;
+        }
+
+        int slot = -1;
+
+        if (!acquireSlot(slot))
+        {
+            // NOTE: the host is busy, try again on the next dispatch
+            executable->setOutputSink(nullptr);
+            d->taskQueue.returnTask(executable);
+            break;
+        }
+
+        emit beginTask(executable);
+
+        startTask(executable, slot);
+    }
+
+    if (!hasPendingTasks() && d->eventLoop)
+    {
+        d->eventLoop->quit();
+    }
+}
+
+void ADTExecutor::reportIdleWait()
+{
+    if (d->taskQueue.isEmpty())
+    {
+        return;
+    }
+
+    if (!d->idleWaitTimer.isValid())
+    {
+        d->idleWaitTimer.start();
+        d->idleWaitReports = 0;
+
+        return;
+    }
+
+    qint64 waitTime = d->idleWaitTimer.elapsed();
+
+    // NOTE: a long wait isn't silent, so a run in background mode doesn't look hung
+    if (waitTime / IDLE_WAIT_REPORT_INTERVAL > d->idleWaitReports)
+    {
+        d->idleWaitReports = waitTime / IDLE_WAIT_REPORT_INTERVAL;
+
+        emit waitingForIdleHost(waitTime);
+    }
+}
+
+bool ADTExecutor::hasPendingTasks()
+{
+    if (!d->runningTasks.empty())
+    {
+        return true;
+    }
+
+    return !d->taskQueue.isEmpty();
+}
+
+bool ADTExecutor::acquireSlot(int &slot)
+{
+    if (!d->admissionControl)
+    {
+        return true;
+    }
+
+    slot = d->admissionControl->tryAcquire();
+
+    if (slot == -1)
+    {
+        if (!d->admissionTimer.isValid())
+        {
+            d->admissionTimer.start();
+        }
+
+        return false;
+    }
+
+    if (d->admissionTimer.isValid())
+    {
+        d->admissionWaitTime += d->admissionTimer.elapsed();
+        d->admissionTimer.invalidate();
+    }
+
+    return true;
+}
+
+void ADTExecutor::startTask(ADTExecutable *task, int slot)
+{
+    QString signalPrefix = d->connection.baseService();
     signalPrefix.replace(':', '_');
     signalPrefix.replace('.', '_');
 
-    QString stdoutSignal = STDOUT_SIGNAL_NAME + signalPrefix;
-    QString stderrSignal = STDERR_SIGNAL_NAME + signalPrefix;
+    std::unique_ptr<ADTRunningTask> runningTask = std::make_unique<ADTRunningTask>();
+    runningTask->task                           = task;
+    runningTask->stdoutSignal                   = STDOUT_SIGNAL_NAME + signalPrefix;
+    runningTask->stderrSignal                   = STDERR_SIGNAL_NAME + signalPrefix;
+    runningTask->slot                           = slot;
+
+    d->outputTargets[task->m_dbusPath] = task;
+
+    connectTaskSignals(d->connection, task, runningTask->stdoutSignal, runningTask->stderrSignal);
+
+    QDBusMessage message = QDBusMessage::createMethodCall(task->m_dbusServiceName,
+                                                          task->m_dbusPath,
+                                                          task->m_dbusInterfaceName,
+                                                          task->m_dbusRunMethodName);
+    message << task->m_id;
+
+    runningTask->timer.start();
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(d->connection.asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &ADTExecutor::onTaskCallFinished);
+
+    d->taskQueue.setToolBusy(task->m_toolId, true);
+    d->runningTasks[watcher] = std::move(runningTask);
+}
+
+void ADTExecutor::onTaskCallFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+
+    auto it = d->runningTasks.find(watcher);
+
+    if (it == d->runningTasks.end())
+    {
+        return;
+    }
+
+    std::unique_ptr<ADTRunningTask> runningTask = std::move(it->second);
+    d->runningTasks.erase(it);
+
+    ADTExecutable *task = runningTask->task;
+
+    disconnectTaskSignals(d->connection, task, runningTask->stdoutSignal, runningTask->stderrSignal);
+
+    d->outputTargets.remove(task->m_dbusPath);
 
-    connectTaskSignals(dbusIface, task, stdoutSignal, stderrSignal);
+    task->flushOutput();
 
-    QDBusReply<int> reply = dbusIface.call(task->m_dbusRunMethodName, task->m_id);
+    d->taskQueue.setToolBusy(task->m_toolId, false);
 
-    if (!reply.isValid())
+    if (d->admissionControl)
+    {
+        d->admissionControl->release(runningTask->slot);
+    }
+
+    QDBusPendingReply<int> reply = *watcher;
+
+    if (reply.isError())
     {
         task->m_exit_code = -1;
         task->getStderr(reply.error().message());
-        return;
+        task->flushOutput();
+    }
+    else
+    {
+        task->m_exit_code = reply.value();
+
+        if (d->resultCache)
+        {
+            d->resultCache->store(task);
+        }
+    }
+
+    task->setOutputSink(nullptr);
+
+    if (d->runHistory)
+    {
+        d->runHistory->addRun(task, runningTask->timer.elapsed(), task->m_exit_code != 0);
     }
 
-    disconnectTaskSignals(dbusIface, task, stdoutSignal, stderrSignal);
+    emit finishTask(task);
+
+    // NOTE: output of finished tests is rarely viewed again
+    task->m_logStore.compressInBackground();
+
+    dispatchTasks();
+}
+
+void ADTExecutor::onOutputSignal(QString text, const QDBusMessage &message)
+{
+    ADTExecutable *task = d->outputTargets.value(message.path(), nullptr);
+
+    if (!task)
+    {
+        return;
+    }
 
-    task->m_exit_code = reply.value();
+    // NOTE: output is received in the thread of the executor, so it's in the store before the reply is handled
+    task->receiveOutput(message.member().startsWith(STDERR_SIGNAL_NAME) ? ADTLogStore::Stderr : ADTLogStore::Stdout,
+                        text.toUtf8());
 }
 
-void ADTExecutor::connectTaskSignals(QDBusInterface &iface,
+void ADTExecutor::connectTaskSignals(QDBusConnection &conn,
                                      ADTExecutable *task,
                                      QString stdoutSignalName,
                                      QString stderrSignalName)
 {
-    iface.connection().connect(task->m_dbusServiceName,
-                               task->m_dbusPath,
-                               task->m_dbusInterfaceName,
-                               stdoutSignalName,
-                               task,
-                               SLOT(getStdout(QString)));
-
-    iface.connection().connect(task->m_dbusServiceName,
-                               task->m_dbusPath,
-                               task->m_dbusInterfaceName,
-                               stderrSignalName,
-                               task,
-                               SLOT(getStderr(QString)));
+    conn.connect(task->m_dbusServiceName,
+                 task->m_dbusPath,
+                 task->m_dbusInterfaceName,
+                 stdoutSignalName,
+                 this,
+                 SLOT(onOutputSignal(QString,QDBusMessage)));
+
+    conn.connect(task->m_dbusServiceName,
+                 task->m_dbusPath,
+                 task->m_dbusInterfaceName,
+                 stderrSignalName,
+                 this,
+                 SLOT(onOutputSignal(QString,QDBusMessage)));
 }
 
-void ADTExecutor::disconnectTaskSignals(QDBusInterface &iface,
+void ADTExecutor::disconnectTaskSignals(QDBusConnection &conn,
                                         ADTExecutable *task,
                                         QString stdoutSignalName,
                                         QString stderrSignalName)
 {
-    iface.connection().disconnect(task->m_dbusServiceName,
-                                  task->m_dbusPath,
-                                  task->m_dbusInterfaceName,
-                                  stdoutSignalName,
-                                  task,
-                                  SLOT(getStdout(QString)));
-
-    iface.connection().disconnect(task->m_dbusServiceName,
-                                  task->m_dbusPath,
-                                  task->m_dbusInterfaceName,
-                                  stderrSignalName,
-                                  task,
-                                  SLOT(getStderr(QString)));
+    conn.disconnect(task->m_dbusServiceName,
+                    task->m_dbusPath,
+                    task->m_dbusInterfaceName,
+                    stdoutSignalName,
+                    this,
+                    SLOT(onOutputSignal(QString,QDBusMessage)));
+
+    conn.disconnect(task->m_dbusServiceName,
+                    task->m_dbusPath,
+                    task->m_dbusInterfaceName,
+                    stderrSignalName,
+                    this,
+                    SLOT(onOutputSignal(QString,QDBusMessage)));
 }
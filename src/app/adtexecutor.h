@@ -21,9 +21,17 @@
 #ifndef ADTEXECUTOR_H
 #define ADTEXECUTOR_H
 
+#include "adtadmissioncontrol.h"
+#include "adtidlemonitor.h"
+#include "adtresultcache.h"
+#include "adtrunhistory.h"
+#include "../core/adtlineclassifier.h"
+#include "../core/adtoutputsink.h"
 #include "mainwindow/statuscommonwidget.h"
 
-#include <QDBusInterface>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
 #include <QObject>
 
 class ADTExecutorPrivate;
@@ -51,24 +59,70 @@ public:
 
     void setTasks(std::vector<ADTExecutable *> &tasks);
 
+    void setResultCache(ADTResultCache *cache);
+
+    void setConnection(QDBusConnection conn);
+
+    void setRunHistory(ADTRunHistory *history);
+
+    void setTimeBudget(qint64 budget);
+
+    void setAdmissionControl(ADTAdmissionControl *admissionControl);
+
+    // Total time tasks waited for a free host slot during the last run, msec
+    qint64 getAdmissionWaitTime();
+
+    void setIdleMonitor(ADTIdleMonitor *monitor);
+
+    void setLineClassifier(ADTLineClassifier *classifier);
+
+    // Bytes of output of each test kept from its beginning and its end, 0 and 0 - unlimited
+    void setOutputLimits(qint64 headBytes, qint64 tailBytes);
+
+    // Output of each test is written to the sink too, nullptr - not written
+    void setOutputSink(ADTOutputSink *sink);
+
+    void setMaxConcurrentTasks(int count);
+
+    // Share of the schedule of the tool, ignored in runs with a time budget where the planner order wins
+    void setToolWeight(QString toolId, int weight);
+
 public slots:
     void runTasks();
 
 signals:
     void beginTask(ADTExecutable *currentExecutable);
     void finishTask(ADTExecutable *currentExecutable);
+    void skipTask(ADTExecutable *currentExecutable);
 
     void allTaskBegin();
     void allTasksFinished();
 
+    // Queued tasks have been waiting for an idle host for waitTime msec, emitted about once a minute
+    void waitingForIdleHost(qint64 waitTime);
+
+private slots:
+    void dispatchTasks();
+
+    void onTaskCallFinished(QDBusPendingCallWatcher *watcher);
+
+    void onOutputSignal(QString text, const QDBusMessage &message);
+
 private:
-    void executeTask(ADTExecutable *task);
+    // Emits waitingForIdleHost() while queued tasks are kept back by the idle monitor
+    void reportIdleWait();
+
+    bool hasPendingTasks();
+
+    bool acquireSlot(int &slot);
+
+    void startTask(ADTExecutable *task, int slot);
 
-    void connectTaskSignals(QDBusInterface &iface,
+    void connectTaskSignals(QDBusConnection &conn,
                             ADTExecutable *task,
                             QString stdoutSignalName,
                             QString stderrSignalName);
-    void disconnectTaskSignals(QDBusInterface &iface,
+    void disconnectTaskSignals(QDBusConnection &conn,
                                ADTExecutable *task,
                                QString stdoutSignalName,
                                QString stderrSignalName);
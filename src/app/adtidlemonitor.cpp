@@ -0,0 +1,222 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtidlemonitor.h"
+
+#include <algorithm>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThread>
+
+const double ADTIdleMonitor::MAX_LOAD_PER_CPU = 0.7;
+const double ADTIdleMonitor::MAX_PRESSURE     = 10.0;
+const double ADTIdleMonitor::MIN_CPU_IDLE     = 0.3;
+const int ADTIdleMonitor::SAMPLE_INTERVAL     = 1000;
+
+const char *const LOADAVG_PATH          = "/proc/loadavg";
+const char *const PRESSURE_PATH_PREFIX  = "/proc/pressure/";
+const char *const PRESSURE_SOME_PREFIX  = "some ";
+const char *const PRESSURE_AVG10_PREFIX = "avg10=";
+const char *const STAT_PATH             = "/proc/stat";
+const char *const TASKS_PATH            = "/proc/self/task";
+
+// See linux/ioprio.h
+const int IOPRIO_WHO_PROCESS = 1;
+const int IOPRIO_CLASS_IDLE  = 3;
+const int IOPRIO_CLASS_SHIFT = 13;
+
+class ADTIdleMonitorPrivate
+{
+public:
+    ADTIdleMonitorPrivate()
+        : m_sampleTimer()
+        , m_lastBusy(0)
+        , m_lastTotal(0)
+        , m_isIdle(true)
+    {}
+
+    ~ADTIdleMonitorPrivate() = default;
+
+    QElapsedTimer m_sampleTimer;
+
+    // CPU times of the previous sample in clock ticks
+    qint64 m_lastBusy;
+    qint64 m_lastTotal;
+
+    bool m_isIdle;
+
+private:
+    ADTIdleMonitorPrivate(const ADTIdleMonitorPrivate &) = delete;
+    ADTIdleMonitorPrivate(ADTIdleMonitorPrivate &&)      = delete;
+    ADTIdleMonitorPrivate &operator=(const ADTIdleMonitorPrivate &) = delete;
+    ADTIdleMonitorPrivate &operator=(ADTIdleMonitorPrivate &&) = delete;
+};
+
+ADTIdleMonitor::ADTIdleMonitor()
+    : d(std::make_unique<ADTIdleMonitorPrivate>())
+{
+    readCpuTimes(d->m_lastBusy, d->m_lastTotal);
+}
+
+ADTIdleMonitor::~ADTIdleMonitor() {}
+
+bool ADTIdleMonitor::isIdle()
+{
+    if (!d->m_sampleTimer.isValid() || d->m_sampleTimer.elapsed() >= SAMPLE_INTERVAL)
+    {
+        sample();
+    }
+
+    return d->m_isIdle;
+}
+
+void ADTIdleMonitor::lowerOwnPriority()
+{
+    bool isCpuPriorityLowered = true;
+    bool isIoPriorityLowered  = true;
+
+    // NOTE: on Linux both priorities belong to a thread, not to the process, so every existing thread is
+    // changed. Threads created later inherit the priorities of the thread which creates them
+    for (const QString &threadId : QDir(TASKS_PATH).entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        int id = threadId.toInt();
+
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(id), 19) == -1)
+        {
+            isCpuPriorityLowered = false;
+        }
+
+        if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, id, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT) == -1)
+        {
+            isIoPriorityLowered = false;
+        }
+    }
+
+    if (!isCpuPriorityLowered)
+    {
+        qWarning() << "WARNING! Can't lower CPU priority of the process";
+    }
+
+    if (!isIoPriorityLowered)
+    {
+        qWarning() << "WARNING! Can't lower IO priority of the process";
+    }
+}
+
+void ADTIdleMonitor::sample()
+{
+    d->m_sampleTimer.start();
+
+    double cpuIdle = 1.0;
+    qint64 busy    = 0;
+    qint64 total   = 0;
+
+    if (readCpuTimes(busy, total) && total > d->m_lastTotal)
+    {
+        cpuIdle = 1.0 - static_cast<double>(busy - d->m_lastBusy) / (total - d->m_lastTotal);
+
+        d->m_lastBusy  = busy;
+        d->m_lastTotal = total;
+    }
+
+    d->m_isIdle = getLoadPerCpu() < MAX_LOAD_PER_CPU && getPressure("cpu") < MAX_PRESSURE
+                  && getPressure("io") < MAX_PRESSURE && cpuIdle > MIN_CPU_IDLE;
+}
+
+double ADTIdleMonitor::getLoadPerCpu()
+{
+    QFile file(LOADAVG_PATH);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return 0.0;
+    }
+
+    double load = QString(file.readLine()).section(' ', 0, 0).toDouble();
+
+    return load / std::max(1, QThread::idealThreadCount());
+}
+
+double ADTIdleMonitor::getPressure(QString resource)
+{
+    // NOTE: PSI is absent on old kernels and may be disabled with psi=0
+    QFile file(PRESSURE_PATH_PREFIX + resource);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return 0.0;
+    }
+
+    // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    while (!file.atEnd())
+    {
+        QString line = file.readLine();
+
+        if (!line.startsWith(PRESSURE_SOME_PREFIX))
+        {
+            continue;
+        }
+
+        for (const QString &field : line.split(' ', Qt::SkipEmptyParts))
+        {
+            if (field.startsWith(PRESSURE_AVG10_PREFIX))
+            {
+                return field.mid(QString(PRESSURE_AVG10_PREFIX).size()).toDouble();
+            }
+        }
+    }
+
+    return 0.0;
+}
+
+bool ADTIdleMonitor::readCpuTimes(qint64 &busy, qint64 &total)
+{
+    QFile file(STAT_PATH);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    // cpu user nice system idle iowait irq softirq steal guest guest_nice
+    QStringList fields = QString(file.readLine()).trimmed().split(' ', Qt::SkipEmptyParts);
+
+    if (fields.size() < 6 || fields[0] != "cpu")
+    {
+        return false;
+    }
+
+    total = 0;
+
+    // NOTE: guest times are already included in user and nice
+    for (int i = 1; i < std::min(static_cast<int>(fields.size()), 9); i++)
+    {
+        total += fields[i].toLongLong();
+    }
+
+    busy = total - fields[4].toLongLong() - fields[5].toLongLong();
+
+    return true;
+}
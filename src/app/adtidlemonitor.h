@@ -0,0 +1,70 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTIDLEMONITOR_H
+#define ADTIDLEMONITOR_H
+
+#include <memory>
+#include <QString>
+
+class ADTIdleMonitorPrivate;
+
+/*
+ * Tells whether the host is idle enough to start one more test in background mode.
+ * The host is busy when any of load average per CPU, PSI pressure of CPU or IO
+ * or CPU utilization since the previous sample is above its threshold.
+ */
+class ADTIdleMonitor
+{
+public:
+    static const double MAX_LOAD_PER_CPU;
+    static const double MAX_PRESSURE;
+    static const double MIN_CPU_IDLE;
+
+    // Interval between samples of /proc, msec
+    static const int SAMPLE_INTERVAL;
+
+public:
+    ADTIdleMonitor();
+    ~ADTIdleMonitor();
+
+    bool isIdle();
+
+    // Sets the lowest CPU and IO priority for all threads of the process, including ones created later
+    static void lowerOwnPriority();
+
+private:
+    void sample();
+
+    static double getLoadPerCpu();
+    static double getPressure(QString resource);
+    static bool readCpuTimes(qint64 &busy, qint64 &total);
+
+private:
+    std::unique_ptr<ADTIdleMonitorPrivate> d;
+
+private:
+    ADTIdleMonitor(const ADTIdleMonitor &) = delete;
+    ADTIdleMonitor(ADTIdleMonitor &&)      = delete;
+    ADTIdleMonitor &operator=(const ADTIdleMonitor &) = delete;
+    ADTIdleMonitor &operator=(ADTIdleMonitor &&) = delete;
+};
+
+#endif // ADTIDLEMONITOR_H
@@ -0,0 +1,183 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtlogsearch.h"
+#include "../core/adtutf8decoder.h"
+
+const int ADTLogSearch::LINES_PER_JOB   = 10000;
+const int ADTLogSearch::UPDATE_INTERVAL = 500;
+
+ADTLogSearch::ADTLogSearch(QObject *parent)
+    : QObject(parent)
+    , m_literal()
+    , m_regex()
+    , m_isRegex(false)
+    , m_tasks()
+    , m_generation(0)
+    , m_pool()
+    , m_timer()
+{
+    m_timer.setInterval(UPDATE_INTERVAL);
+
+    connect(&m_timer, &QTimer::timeout, this, &ADTLogSearch::scan);
+}
+
+ADTLogSearch::~ADTLogSearch()
+{
+    stop();
+
+    // NOTE: jobs use the logs and post results to this object
+    m_pool.waitForDone();
+}
+
+bool ADTLogSearch::start(QString pattern, bool isRegex, std::vector<ADTExecutable *> tasks)
+{
+    stop();
+
+    if (isRegex)
+    {
+        m_regex = QRegularExpression(pattern);
+
+        if (!m_regex.isValid())
+        {
+            return false;
+        }
+
+        m_regex.optimize();
+    }
+
+    m_literal = pattern.toUtf8();
+    m_isRegex = isRegex;
+
+    for (ADTExecutable *task : tasks)
+    {
+        m_tasks[task] = TaskState{task->m_logStore.getGeneration(), 0, 0};
+    }
+
+    m_timer.start();
+
+    scan();
+
+    return true;
+}
+
+void ADTLogSearch::stop()
+{
+    m_timer.stop();
+    m_tasks.clear();
+    m_generation++;
+}
+
+bool ADTLogSearch::isActive()
+{
+    return m_timer.isActive();
+}
+
+void ADTLogSearch::scan()
+{
+    for (auto &item : m_tasks)
+    {
+        ADTExecutable *task = item.first;
+        TaskState &state    = item.second;
+
+        if (state.runningJobs > 0)
+        {
+            continue;
+        }
+
+        // NOTE: the generation is read first, so a clear between the two reads is noticed on the next scan
+        quint64 storeGeneration = task->m_logStore.getGeneration();
+        qint64 lineCount        = task->m_logStore.getLineCount();
+
+        // NOTE: the store may be cleared and refilled past the scanned lines between two scans
+        if (storeGeneration != state.storeGeneration || lineCount < state.scannedLines)
+        {
+            state.storeGeneration = storeGeneration;
+            state.scannedLines    = 0;
+
+            emit taskReset(task);
+        }
+
+        for (qint64 from = state.scannedLines; from < lineCount; from += LINES_PER_JOB)
+        {
+            startJob(task, from, std::min<qint64>(LINES_PER_JOB, lineCount - from));
+
+            state.runningJobs++;
+        }
+
+        state.scannedLines = lineCount;
+    }
+}
+
+void ADTLogSearch::startJob(ADTExecutable *task, qint64 from, qint64 count)
+{
+    quint64 generation = m_generation;
+    QByteArray literal = m_literal;
+    bool isRegex       = m_isRegex;
+
+    // NOTE: each job uses its own copy of the expression
+    QRegularExpression regex = m_regex;
+
+    m_pool.start([this, task, from, count, generation, literal, isRegex, regex]() {
+        std::vector<std::pair<qint64, QString>> matches;
+
+        std::vector<ADTLogStore::Line> lines = task->m_logStore.getLines(from, count);
+
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            const QByteArray &data = lines[i].data;
+
+            // NOTE: literals are matched on raw bytes, only matched lines are decoded
+            if (isRegex ? regex.match(ADTUtf8Decoder::decode(data)).hasMatch() : data.contains(literal))
+            {
+                matches.emplace_back(from + static_cast<qint64>(i), ADTUtf8Decoder::decode(data));
+            }
+        }
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, task, matches]() { onJobFinished(generation, task, matches); },
+            Qt::QueuedConnection);
+    });
+}
+
+void ADTLogSearch::onJobFinished(quint64 generation,
+                                 ADTExecutable *task,
+                                 std::vector<std::pair<qint64, QString>> matches)
+{
+    if (generation != m_generation)
+    {
+        return;
+    }
+
+    auto it = m_tasks.find(task);
+
+    if (it == m_tasks.end())
+    {
+        return;
+    }
+
+    it->second.runningJobs--;
+
+    for (auto &match : matches)
+    {
+        emit matchFound(task, match.first, match.second);
+    }
+}
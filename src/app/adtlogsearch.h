@@ -0,0 +1,101 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTLOGSEARCH_H
+#define ADTLOGSEARCH_H
+
+#include "../core/adtexecutable.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <QObject>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QTimer>
+
+/*
+ * Searches output of many tests for a literal or a regular expression.
+ * Line ranges of the logs are matched in a thread pool, matches are reported as they are found.
+ * While the search is active, lines added to the logs are searched too.
+ */
+class ADTLogSearch : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Number of lines matched by one job of the pool
+    static const int LINES_PER_JOB;
+
+    // Interval of checking logs for new lines, msec
+    static const int UPDATE_INTERVAL;
+
+public:
+    ADTLogSearch(QObject *parent = nullptr);
+    ~ADTLogSearch();
+
+    // Returns false if the regular expression is not valid
+    bool start(QString pattern, bool isRegex, std::vector<ADTExecutable *> tasks);
+    void stop();
+
+    bool isActive();
+
+signals:
+    void matchFound(ADTExecutable *task, qint64 line, QString text);
+
+    // Output of the test was cleared, its previous matches are not valid anymore
+    void taskReset(ADTExecutable *task);
+
+private slots:
+    void scan();
+
+private:
+    struct TaskState
+    {
+        quint64 storeGeneration;
+        qint64 scannedLines;
+        int runningJobs;
+    };
+
+private:
+    void startJob(ADTExecutable *task, qint64 from, qint64 count);
+    void onJobFinished(quint64 generation, ADTExecutable *task, std::vector<std::pair<qint64, QString>> matches);
+
+private:
+    QByteArray m_literal;
+    QRegularExpression m_regex;
+    bool m_isRegex;
+
+    std::map<ADTExecutable *, TaskState> m_tasks;
+
+    // Incremented on every start and stop to drop results of previous searches
+    quint64 m_generation;
+
+    QThreadPool m_pool;
+    QTimer m_timer;
+
+private:
+    ADTLogSearch(const ADTLogSearch &) = delete;
+    ADTLogSearch(ADTLogSearch &&)      = delete;
+    ADTLogSearch &operator=(const ADTLogSearch &) = delete;
+    ADTLogSearch &operator=(ADTLogSearch &&) = delete;
+};
+
+#endif // ADTLOGSEARCH_H
@@ -0,0 +1,56 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtrefreshthrottle.h"
+
+const int ADTRefreshThrottle::DEFAULT_INTERVAL = 33;
+
+ADTRefreshThrottle::ADTRefreshThrottle(int interval, QObject *parent)
+    : QObject(parent)
+    , m_timer()
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(interval);
+
+    connect(&m_timer, &QTimer::timeout, this, &ADTRefreshThrottle::flush);
+}
+
+ADTRefreshThrottle::~ADTRefreshThrottle() {}
+
+void ADTRefreshThrottle::discard()
+{
+    m_timer.stop();
+}
+
+void ADTRefreshThrottle::request()
+{
+    // NOTE: the timer isn't restarted, so a steady stream of output doesn't postpone the refresh
+    if (!m_timer.isActive())
+    {
+        m_timer.start();
+    }
+}
+
+void ADTRefreshThrottle::flush()
+{
+    m_timer.stop();
+
+    emit refreshRequested();
+}
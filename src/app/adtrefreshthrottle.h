@@ -0,0 +1,63 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTREFRESHTHROTTLE_H
+#define ADTREFRESHTHROTTLE_H
+
+#include <QObject>
+#include <QTimer>
+
+/*
+ * Turns frequent notifications about new output into refreshes of widgets
+ * not more often than once per interval. Widgets read the output themselves.
+ */
+class ADTRefreshThrottle : public QObject
+{
+    Q_OBJECT
+
+public:
+    // About 30 refreshes per second, msec
+    static const int DEFAULT_INTERVAL;
+
+public:
+    ADTRefreshThrottle(int interval = DEFAULT_INTERVAL, QObject *parent = nullptr);
+    ~ADTRefreshThrottle();
+
+    // Drops the pending refresh
+    void discard();
+
+signals:
+    void refreshRequested();
+
+public slots:
+    void request();
+    void flush();
+
+private:
+    QTimer m_timer;
+
+private:
+    ADTRefreshThrottle(const ADTRefreshThrottle &) = delete;
+    ADTRefreshThrottle(ADTRefreshThrottle &&)      = delete;
+    ADTRefreshThrottle &operator=(const ADTRefreshThrottle &) = delete;
+    ADTRefreshThrottle &operator=(ADTRefreshThrottle &&) = delete;
+};
+
+#endif // ADTREFRESHTHROTTLE_H
@@ -0,0 +1,218 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtresultcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+const int ADTResultCache::DEFAULT_TTL = 300;
+
+// NOTE: increment when the stored fields are changed, older entries are ignored
+const int ENTRY_VERSION = 2;
+
+const char *const RPM_DATABASE_PATHS[] = {"/var/lib/rpm/Packages", "/var/lib/rpm/rpmdb.sqlite", "/var/lib/rpm"};
+const char *const BOOT_ID_PATH         = "/proc/sys/kernel/random/boot_id";
+
+const char *const ENTRY_VERSION_KEY     = "version";
+const char *const ENTRY_FINGERPRINT_KEY = "fingerprint";
+const char *const ENTRY_TIMESTAMP_KEY   = "timestamp";
+const char *const ENTRY_EXIT_CODE_KEY   = "exit_code";
+const char *const ENTRY_OUTPUT_KEY      = "output";
+const char *const CHUNK_STREAM_KEY      = "stream";
+const char *const CHUNK_DATA_KEY        = "data";
+const char *const CHUNK_REPEATS_KEY     = "repeats";
+
+class ADTResultCachePrivate
+{
+public:
+    ADTResultCachePrivate(QString cacheDir, int ttl)
+        : m_cacheDir(cacheDir)
+        , m_ttl(ttl)
+    {}
+
+    ~ADTResultCachePrivate() = default;
+
+    QString m_cacheDir;
+    int m_ttl;
+
+private:
+    ADTResultCachePrivate(const ADTResultCachePrivate &) = delete;
+    ADTResultCachePrivate(ADTResultCachePrivate &&)      = delete;
+    ADTResultCachePrivate &operator=(const ADTResultCachePrivate &) = delete;
+    ADTResultCachePrivate &operator=(ADTResultCachePrivate &&) = delete;
+};
+
+ADTResultCache::ADTResultCache(QString cacheDir, int ttl)
+    : d(std::make_unique<ADTResultCachePrivate>(cacheDir, ttl))
+{
+    if (!QDir().mkpath(d->m_cacheDir))
+    {
+        qWarning() << "WARNING! Can't create result cache directory: " << d->m_cacheDir;
+    }
+}
+
+ADTResultCache::~ADTResultCache() {}
+
+bool ADTResultCache::lookup(ADTExecutable *task)
+{
+    QFile entryFile(getEntryFileName(task));
+
+    if (!entryFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QJsonObject entry = QJsonDocument::fromJson(entryFile.readAll()).object();
+
+    if (entry.value(ENTRY_VERSION_KEY).toInt() != ENTRY_VERSION
+        || entry.value(ENTRY_FINGERPRINT_KEY).toString() != getFingerprint(task))
+    {
+        return false;
+    }
+
+    qint64 age = QDateTime::currentSecsSinceEpoch()
+                 - static_cast<qint64>(entry.value(ENTRY_TIMESTAMP_KEY).toDouble());
+
+    if (age < 0 || age > d->m_ttl)
+    {
+        return false;
+    }
+
+    task->m_exit_code = entry.value(ENTRY_EXIT_CODE_KEY).toInt(-1);
+    task->m_cached    = true;
+
+    // NOTE: the output was capped when it was stored, its markers must not be capped again
+    qint64 headLimit = task->m_outputHeadLimit;
+    qint64 tailLimit = task->m_outputTailLimit;
+
+    task->m_outputHeadLimit = 0;
+    task->m_outputTailLimit = 0;
+
+    for (const QJsonValue &value : entry.value(ENTRY_OUTPUT_KEY).toArray())
+    {
+        QJsonObject chunk = value.toObject();
+
+        ADTLogStore::Stream stream = chunk.value(CHUNK_STREAM_KEY).toInt() == ADTLogStore::Stderr
+                                         ? ADTLogStore::Stderr
+                                         : ADTLogStore::Stdout;
+        QByteArray data            = QByteArray::fromBase64(chunk.value(CHUNK_DATA_KEY).toString().toLatin1());
+        int repeats                = chunk.value(CHUNK_REPEATS_KEY).toInt(1);
+
+        // NOTE: copies of a repeated line are collapsed by the store again
+        for (int i = 0; i < repeats; i++)
+        {
+            task->receiveOutput(stream, data);
+        }
+    }
+
+    task->flushOutput();
+
+    task->m_outputHeadLimit = headLimit;
+    task->m_outputTailLimit = tailLimit;
+
+    return true;
+}
+
+void ADTResultCache::store(ADTExecutable *task)
+{
+    QJsonArray output;
+
+    // NOTE: output isn't always valid UTF-8, so it is kept byte for byte in base64
+    task->m_logStore.forEachRun(ADTLogStore::All,
+                                [&output](ADTLogStore::Stream stream, const QByteArray &data, quint64 repeats) {
+                                    QJsonObject value;
+                                    value[CHUNK_STREAM_KEY] = static_cast<int>(stream);
+                                    value[CHUNK_DATA_KEY]   = QString::fromLatin1(data.toBase64());
+
+                                    if (repeats > 1)
+                                    {
+                                        value[CHUNK_REPEATS_KEY] = static_cast<double>(repeats);
+                                    }
+
+                                    output.append(value);
+                                });
+
+    QJsonObject entry;
+    entry[ENTRY_VERSION_KEY]     = ENTRY_VERSION;
+    entry[ENTRY_FINGERPRINT_KEY] = getFingerprint(task);
+    entry[ENTRY_TIMESTAMP_KEY]   = static_cast<double>(QDateTime::currentSecsSinceEpoch());
+    entry[ENTRY_EXIT_CODE_KEY]   = task->m_exit_code;
+    entry[ENTRY_OUTPUT_KEY]      = output;
+
+    QSaveFile entryFile(getEntryFileName(task));
+
+    if (!entryFile.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "WARNING! Can't write result cache entry for test: " << task->m_id;
+        return;
+    }
+
+    entryFile.write(QJsonDocument(entry).toJson(QJsonDocument::Compact));
+    entryFile.commit();
+}
+
+QString ADTResultCache::getEntryFileName(ADTExecutable *task)
+{
+    QByteArray key = QString("%1\n%2\n%3").arg(task->m_toolId, task->m_id, task->m_args).toUtf8();
+
+    return d->m_cacheDir + "/" + QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex() + ".json";
+}
+
+QString ADTResultCache::getFingerprint(ADTExecutable *task)
+{
+    // NOTE: the system stamp is read for every test, packages may be changed while tests are running
+    return getRpmDatabaseStamp() + ";" + getBootId() + ";" + task->m_infoHash;
+}
+
+QString ADTResultCache::getRpmDatabaseStamp()
+{
+    for (const char *path : RPM_DATABASE_PATHS)
+    {
+        QFileInfo info(path);
+
+        if (info.exists())
+        {
+            return QString::number(info.lastModified().toMSecsSinceEpoch());
+        }
+    }
+
+    return QString();
+}
+
+QString ADTResultCache::getBootId()
+{
+    QFile bootIdFile(BOOT_ID_PATH);
+
+    if (!bootIdFile.open(QIODevice::ReadOnly))
+    {
+        return QString();
+    }
+
+    return QString(bootIdFile.readAll()).trimmed();
+}
@@ -0,0 +1,65 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTRESULTCACHE_H
+#define ADTRESULTCACHE_H
+
+#include "../core/adtexecutable.h"
+
+#include <memory>
+#include <QString>
+
+class ADTResultCachePrivate;
+
+/*
+ * Keeps results of finished tests on disk keyed by (tool, test, args).
+ * An entry is valid while it is younger than ttl and the fingerprint of the
+ * system (rpm database mtime, Info hash of the tool, boot id) is unchanged.
+ */
+class ADTResultCache
+{
+public:
+    static const int DEFAULT_TTL;
+
+public:
+    ADTResultCache(QString cacheDir, int ttl);
+    ~ADTResultCache();
+
+    bool lookup(ADTExecutable *task);
+    void store(ADTExecutable *task);
+
+private:
+    QString getEntryFileName(ADTExecutable *task);
+    QString getFingerprint(ADTExecutable *task);
+
+    static QString getRpmDatabaseStamp();
+    static QString getBootId();
+
+private:
+    std::unique_ptr<ADTResultCachePrivate> d;
+
+private:
+    ADTResultCache(const ADTResultCache &) = delete;
+    ADTResultCache(ADTResultCache &&)      = delete;
+    ADTResultCache &operator=(const ADTResultCache &) = delete;
+    ADTResultCache &operator=(ADTResultCache &&) = delete;
+};
+
+#endif // ADTRESULTCACHE_H
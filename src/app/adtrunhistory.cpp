@@ -0,0 +1,167 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtrunhistory.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QSaveFile>
+
+const char *const RECORD_RUNS_KEY     = "runs";
+const char *const RECORD_FAILURES_KEY = "failures";
+const char *const RECORD_DURATION_KEY = "duration";
+
+// Weight of the last run in the average duration
+const double DURATION_SMOOTHING_FACTOR = 0.3;
+
+class ADTRunHistoryPrivate
+{
+public:
+    ADTRunHistoryPrivate(QString fileName)
+        : m_fileName(fileName)
+        , m_records()
+        , m_isModified(false)
+    {}
+
+    ~ADTRunHistoryPrivate() = default;
+
+    QString m_fileName;
+    QMap<QString, ADTRunHistory::Record> m_records;
+    bool m_isModified;
+
+private:
+    ADTRunHistoryPrivate(const ADTRunHistoryPrivate &) = delete;
+    ADTRunHistoryPrivate(ADTRunHistoryPrivate &&)      = delete;
+    ADTRunHistoryPrivate &operator=(const ADTRunHistoryPrivate &) = delete;
+    ADTRunHistoryPrivate &operator=(ADTRunHistoryPrivate &&) = delete;
+};
+
+ADTRunHistory::ADTRunHistory(QString fileName)
+    : d(std::make_unique<ADTRunHistoryPrivate>(fileName))
+{
+    load();
+}
+
+ADTRunHistory::~ADTRunHistory() {}
+
+bool ADTRunHistory::contains(ADTExecutable *task)
+{
+    return d->m_records.contains(getKey(task));
+}
+
+ADTRunHistory::Record ADTRunHistory::getRecord(ADTExecutable *task)
+{
+    return d->m_records.value(getKey(task));
+}
+
+void ADTRunHistory::addRun(ADTExecutable *task, qint64 duration, bool failed)
+{
+    Record &record = d->m_records[getKey(task)];
+
+    if (record.runs == 0)
+    {
+        record.averageDuration = duration;
+    }
+    else
+    {
+        record.averageDuration = (1.0 - DURATION_SMOOTHING_FACTOR) * record.averageDuration
+                                 + DURATION_SMOOTHING_FACTOR * duration;
+    }
+
+    record.runs++;
+
+    if (failed)
+    {
+        record.failures++;
+    }
+
+    d->m_isModified = true;
+}
+
+void ADTRunHistory::save()
+{
+    if (!d->m_isModified)
+    {
+        return;
+    }
+
+    QJsonObject history;
+
+    for (auto it = d->m_records.begin(); it != d->m_records.end(); ++it)
+    {
+        QJsonObject record;
+        record[RECORD_RUNS_KEY]     = it->runs;
+        record[RECORD_FAILURES_KEY] = it->failures;
+        record[RECORD_DURATION_KEY] = it->averageDuration;
+
+        history[it.key()] = record;
+    }
+
+    QDir().mkpath(QFileInfo(d->m_fileName).absolutePath());
+
+    QSaveFile historyFile(d->m_fileName);
+
+    if (!historyFile.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "WARNING! Can't save run history to file: " << d->m_fileName;
+        return;
+    }
+
+    historyFile.write(QJsonDocument(history).toJson(QJsonDocument::Compact));
+
+    if (historyFile.commit())
+    {
+        d->m_isModified = false;
+    }
+}
+
+QString ADTRunHistory::getKey(ADTExecutable *task)
+{
+    return task->m_toolId + "/" + task->m_id;
+}
+
+void ADTRunHistory::load()
+{
+    QFile historyFile(d->m_fileName);
+
+    if (!historyFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QJsonObject history = QJsonDocument::fromJson(historyFile.readAll()).object();
+
+    for (auto it = history.begin(); it != history.end(); ++it)
+    {
+        QJsonObject recordObject = it.value().toObject();
+
+        Record record;
+        record.runs            = recordObject.value(RECORD_RUNS_KEY).toInt();
+        record.failures        = recordObject.value(RECORD_FAILURES_KEY).toInt();
+        record.averageDuration = recordObject.value(RECORD_DURATION_KEY).toDouble();
+
+        d->m_records[it.key()] = record;
+    }
+}
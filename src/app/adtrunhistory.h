@@ -0,0 +1,71 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTRUNHISTORY_H
+#define ADTRUNHISTORY_H
+
+#include "../core/adtexecutable.h"
+
+#include <memory>
+#include <QString>
+
+class ADTRunHistoryPrivate;
+
+/*
+ * Durations and outcomes of past runs of tests, kept locally and used to plan
+ * time-budgeted runs.
+ */
+class ADTRunHistory
+{
+public:
+    struct Record
+    {
+        int runs{0};
+        int failures{0};
+        double averageDuration{0.0}; // msec
+    };
+
+public:
+    ADTRunHistory(QString fileName);
+    ~ADTRunHistory();
+
+    bool contains(ADTExecutable *task);
+    Record getRecord(ADTExecutable *task);
+
+    void addRun(ADTExecutable *task, qint64 duration, bool failed);
+
+    void save();
+
+private:
+    QString getKey(ADTExecutable *task);
+
+    void load();
+
+private:
+    std::unique_ptr<ADTRunHistoryPrivate> d;
+
+private:
+    ADTRunHistory(const ADTRunHistory &) = delete;
+    ADTRunHistory(ADTRunHistory &&)      = delete;
+    ADTRunHistory &operator=(const ADTRunHistory &) = delete;
+    ADTRunHistory &operator=(ADTRunHistory &&) = delete;
+};
+
+#endif // ADTRUNHISTORY_H
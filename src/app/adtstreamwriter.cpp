@@ -0,0 +1,75 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtstreamwriter.h"
+
+const int ADTStreamWriter::BUFFER_SIZE    = 64 * 1024;
+const int ADTStreamWriter::FLUSH_INTERVAL = 100;
+
+ADTStreamWriter::ADTStreamWriter(FILE *file, QObject *parent)
+    : QObject(parent)
+    , m_file(file)
+    , m_buffer()
+    , m_timer()
+{
+    m_buffer.reserve(BUFFER_SIZE);
+
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(FLUSH_INTERVAL);
+
+    connect(&m_timer, &QTimer::timeout, this, &ADTStreamWriter::flush);
+}
+
+ADTStreamWriter::~ADTStreamWriter()
+{
+    flush();
+}
+
+void ADTStreamWriter::writeLine(const QByteArray &prefix, const QByteArray &line)
+{
+    m_buffer.append(prefix);
+    m_buffer.append(line);
+    m_buffer.append('\n');
+
+    if (m_buffer.size() >= BUFFER_SIZE)
+    {
+        flush();
+    }
+    else if (!m_timer.isActive())
+    {
+        m_timer.start();
+    }
+}
+
+void ADTStreamWriter::flush()
+{
+    m_timer.stop();
+
+    if (m_buffer.isEmpty())
+    {
+        return;
+    }
+
+    // NOTE: std::cout is synchronized with stdio, so the order with other messages is kept
+    std::fwrite(m_buffer.constData(), 1, static_cast<size_t>(m_buffer.size()), m_file);
+    std::fflush(m_file);
+
+    m_buffer.clear();
+}
@@ -0,0 +1,67 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTSTREAMWRITER_H
+#define ADTSTREAMWRITER_H
+
+#include <cstdio>
+#include <QByteArray>
+#include <QObject>
+#include <QTimer>
+
+/*
+ * Prints output lines of tests running at the same time, each line prefixed with its source.
+ * Whole lines are collected in a buffer and written in large blocks, so lines of different
+ * tests are never mixed and the terminal or a pipe isn't flushed for every line.
+ */
+class ADTStreamWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Buffered bytes after which the buffer is written immediately
+    static const int BUFFER_SIZE;
+
+    // Interval of writing the buffer while lines come slowly, msec
+    static const int FLUSH_INTERVAL;
+
+public:
+    ADTStreamWriter(FILE *file, QObject *parent = nullptr);
+    ~ADTStreamWriter();
+
+    void writeLine(const QByteArray &prefix, const QByteArray &line);
+
+public slots:
+    // Must be called before anything else is printed to the file
+    void flush();
+
+private:
+    FILE *m_file;
+    QByteArray m_buffer;
+    QTimer m_timer;
+
+private:
+    ADTStreamWriter(const ADTStreamWriter &) = delete;
+    ADTStreamWriter(ADTStreamWriter &&)      = delete;
+    ADTStreamWriter &operator=(const ADTStreamWriter &) = delete;
+    ADTStreamWriter &operator=(ADTStreamWriter &&) = delete;
+};
+
+#endif // ADTSTREAMWRITER_H
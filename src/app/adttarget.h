@@ -0,0 +1,37 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTTARGET_H
+#define ADTTARGET_H
+
+#include "../core/treemodel.h"
+
+#include <memory>
+#include <QDBusConnection>
+#include <QString>
+
+struct ADTTarget
+{
+    QString address{};
+    QDBusConnection connection{QString()};
+    std::unique_ptr<TreeModel> model{};
+};
+
+#endif // ADTTARGET_H
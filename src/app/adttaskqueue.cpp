@@ -0,0 +1,225 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adttaskqueue.h"
+
+#include <algorithm>
+#include <deque>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QStringList>
+
+class ADTTaskQueuePrivate
+{
+public:
+    ADTTaskQueuePrivate()
+        : toolWeights()
+        , toolOrder()
+        , toolQueues()
+        , toolCurrentWeights()
+        , lastCharges()
+        , lastSelectedTool()
+        , lastTotalWeight(0)
+        , taskRanks()
+        , busyTools()
+    {}
+
+    ~ADTTaskQueuePrivate() = default;
+
+    QMap<QString, int> toolWeights;
+
+    // Queues of tests of each tool and state of the smooth weighted round-robin between them
+    QStringList toolOrder;
+    QMap<QString, std::deque<ADTExecutable *>> toolQueues;
+    QMap<QString, int> toolCurrentWeights;
+
+    // Weights added by the last takeNextTask() to undo them if its task is put back
+    QMap<QString, int> lastCharges;
+    QString lastSelectedTool;
+    int lastTotalWeight;
+
+    // Positions of the tasks in the order of the budget planner, empty if the tasks aren't ranked
+    QHash<ADTExecutable *, int> taskRanks;
+
+    // NOTE: tests of the same tool share D-Bus object and output signals,
+    // so only one test of each tool can be running at a time
+    QSet<QString> busyTools;
+
+private:
+    ADTTaskQueuePrivate(const ADTTaskQueuePrivate &) = delete;
+    ADTTaskQueuePrivate(ADTTaskQueuePrivate &&)      = delete;
+    ADTTaskQueuePrivate &operator=(const ADTTaskQueuePrivate &) = delete;
+    ADTTaskQueuePrivate &operator=(ADTTaskQueuePrivate &&) = delete;
+};
+
+ADTTaskQueue::ADTTaskQueue()
+    : d(std::make_unique<ADTTaskQueuePrivate>())
+{}
+
+ADTTaskQueue::~ADTTaskQueue() {}
+
+void ADTTaskQueue::setToolWeight(QString toolId, int weight)
+{
+    d->toolWeights[toolId] = std::max(1, weight);
+}
+
+void ADTTaskQueue::setTasks(const std::vector<ADTExecutable *> &tasks, bool isRanked)
+{
+    clear();
+
+    for (size_t i = 0; i < tasks.size(); i++)
+    {
+        ADTExecutable *executable = tasks[i];
+
+        if (isRanked)
+        {
+            d->taskRanks[executable] = static_cast<int>(i);
+        }
+
+        if (!d->toolQueues.contains(executable->m_toolId))
+        {
+            d->toolOrder.append(executable->m_toolId);
+        }
+
+        d->toolQueues[executable->m_toolId].push_back(executable);
+    }
+}
+
+void ADTTaskQueue::clear()
+{
+    d->toolOrder.clear();
+    d->toolQueues.clear();
+    d->toolCurrentWeights.clear();
+    d->lastCharges.clear();
+    d->taskRanks.clear();
+    d->busyTools.clear();
+}
+
+bool ADTTaskQueue::isEmpty() const
+{
+    return std::all_of(d->toolQueues.begin(), d->toolQueues.end(), [](const std::deque<ADTExecutable *> &queue) {
+        return queue.empty();
+    });
+}
+
+void ADTTaskQueue::setToolBusy(QString toolId, bool isBusy)
+{
+    if (isBusy)
+    {
+        d->busyTools.insert(toolId);
+    }
+    else
+    {
+        d->busyTools.remove(toolId);
+    }
+}
+
+ADTExecutable *ADTTaskQueue::takeNextTask()
+{
+    QString selectedTool;
+    int totalWeight = 0;
+
+    d->lastCharges.clear();
+
+    // NOTE: with a time budget the planner order wins over the tool weights: queues keep the order
+    // of the planner and the next task is the best ranked head of the queues of the free tools
+    if (!d->taskRanks.isEmpty())
+    {
+        for (const QString &toolId : d->toolOrder)
+        {
+            if (d->toolQueues[toolId].empty() || d->busyTools.contains(toolId))
+            {
+                continue;
+            }
+
+            if (selectedTool.isEmpty()
+                || d->taskRanks.value(d->toolQueues[toolId].front())
+                       < d->taskRanks.value(d->toolQueues[selectedTool].front()))
+            {
+                selectedTool = toolId;
+            }
+        }
+
+        if (selectedTool.isEmpty())
+        {
+            return nullptr;
+        }
+
+        std::deque<ADTExecutable *> &queue = d->toolQueues[selectedTool];
+        ADTExecutable *executable          = queue.front();
+        queue.pop_front();
+
+        return executable;
+    }
+
+    for (const QString &toolId : d->toolOrder)
+    {
+        if (d->toolQueues[toolId].empty() || d->busyTools.contains(toolId))
+        {
+            continue;
+        }
+
+        int weight = d->toolWeights.value(toolId, 1);
+
+        d->toolCurrentWeights[toolId] += weight;
+        d->lastCharges[toolId] = weight;
+        totalWeight += weight;
+
+        if (selectedTool.isEmpty() || d->toolCurrentWeights[toolId] > d->toolCurrentWeights[selectedTool])
+        {
+            selectedTool = toolId;
+        }
+    }
+
+    if (selectedTool.isEmpty())
+    {
+        return nullptr;
+    }
+
+    d->toolCurrentWeights[selectedTool] -= totalWeight;
+
+    d->lastSelectedTool = selectedTool;
+    d->lastTotalWeight  = totalWeight;
+
+    std::deque<ADTExecutable *> &queue = d->toolQueues[selectedTool];
+    ADTExecutable *executable          = queue.front();
+    queue.pop_front();
+
+    return executable;
+}
+
+void ADTTaskQueue::returnTask(ADTExecutable *executable)
+{
+    // NOTE: the task didn't run, so the tools keep their shares of the schedule
+    for (auto it = d->lastCharges.begin(); it != d->lastCharges.end(); ++it)
+    {
+        d->toolCurrentWeights[it.key()] -= it.value();
+    }
+
+    if (!d->lastCharges.isEmpty())
+    {
+        d->toolCurrentWeights[d->lastSelectedTool] += d->lastTotalWeight;
+    }
+
+    d->lastCharges.clear();
+
+    d->toolQueues[executable->m_toolId].push_front(executable);
+}
@@ -0,0 +1,71 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTTASKQUEUE_H
+#define ADTTASKQUEUE_H
+
+#include "../core/adtexecutable.h"
+
+#include <memory>
+#include <vector>
+#include <QString>
+
+class ADTTaskQueuePrivate;
+
+/*
+ * Queues of tests of each tool. The next test is the head of the queue chosen by the smooth
+ * weighted round-robin between the tools, or the best ranked head if the tests are ranked.
+ * Tools which have a running test are passed over.
+ */
+class ADTTaskQueue
+{
+public:
+    ADTTaskQueue();
+    ~ADTTaskQueue();
+
+    void setToolWeight(QString toolId, int weight);
+
+    // Ranked tasks are taken in the given order whatever the tool weights
+    void setTasks(const std::vector<ADTExecutable *> &tasks, bool isRanked);
+
+    // Drops the queued tasks, tool weights are kept
+    void clear();
+
+    bool isEmpty() const;
+
+    void setToolBusy(QString toolId, bool isBusy);
+
+    // Returns nullptr if there are no tasks of free tools
+    ADTExecutable *takeNextTask();
+
+    // Puts the task taken by the last takeNextTask() back and undoes its charge of the tool weights
+    void returnTask(ADTExecutable *executable);
+
+private:
+    std::unique_ptr<ADTTaskQueuePrivate> d;
+
+private:
+    ADTTaskQueue(const ADTTaskQueue &) = delete;
+    ADTTaskQueue(ADTTaskQueue &&)      = delete;
+    ADTTaskQueue &operator=(const ADTTaskQueue &) = delete;
+    ADTTaskQueue &operator=(ADTTaskQueue &&) = delete;
+};
+
+#endif // ADTTASKQUEUE_H
@@ -6,11 +6,16 @@
 class ADTToolObjectHelperPrivate
 {
 public:
-    ADTToolObjectHelperPrivate(TreeItem *item)
-        : m_toolItem(item)
+    ADTToolObjectHelperPrivate(TreeModel *model, TreeItem *item)
+        : m_model(model)
+        , m_toolItem(item)
         , m_tests(){};
 
+    void fetchTests();
+
 public:
+    TreeModel *m_model = nullptr;
+
     TreeItem *m_toolItem = nullptr;
 
     QString m_filter{};
@@ -24,14 +29,31 @@ private:
     ADTToolObjectHelperPrivate &operator=(ADTToolObjectHelperPrivate &&) = delete;
 };
 
-ADTToolObjectHelper::ADTToolObjectHelper(TreeItem *item)
-    : d(std::make_unique<ADTToolObjectHelperPrivate>(item))
+void ADTToolObjectHelperPrivate::fetchTests()
 {
-    for (int i = 0; i < item->childCount(); i++)
+    if (m_toolItem->isFetched() && !m_tests.empty())
+    {
+        return;
+    }
+
+    m_model->fetchTests(m_toolItem);
+
+    m_tests.clear();
+
+    for (int i = 0; i < m_toolItem->childCount(); i++)
     {
-        TreeItem *child = item->child(i);
+        TreeItem *child = m_toolItem->child(i);
+
+        m_tests.push_back(child->getExecutable());
+    }
+}
 
-        d->m_tests.push_back(child->getExecutable());
+ADTToolObjectHelper::ADTToolObjectHelper(TreeModel *model, TreeItem *item)
+    : d(std::make_unique<ADTToolObjectHelperPrivate>(model, item))
+{
+    if (item->isFetched())
+    {
+        d->fetchTests();
     }
 }
 
@@ -49,11 +71,27 @@ ADTExecutable *ADTToolObjectHelper::getToolTask()
 
 std::vector<ADTExecutable *> ADTToolObjectHelper::getAllTasks()
 {
+    d->fetchTests();
+
+    return d->m_tests;
+}
+
+std::vector<ADTExecutable *> ADTToolObjectHelper::getFetchedTasks()
+{
+    if (!d->m_toolItem->isFetched())
+    {
+        return std::vector<ADTExecutable *>();
+    }
+
+    d->fetchTests();
+
     return d->m_tests;
 }
 
 std::vector<ADTExecutable *> ADTToolObjectHelper::getFilteredTasks()
 {
+    d->fetchTests();
+
     if (d->m_filter.isEmpty())
     {
         return d->m_tests;
@@ -72,6 +110,8 @@ std::vector<ADTExecutable *> ADTToolObjectHelper::getFilteredTasks()
 
 ADTExecutable *ADTToolObjectHelper::getTestTask(QString test)
 {
+    d->fetchTests();
+
     for (size_t i = 0; i < d->m_tests.size(); i++)
     {
         if (d->m_tests.at(i)->m_id == test)
@@ -6,6 +6,7 @@
 #include <QDBusConnection>
 
 #include "../core/treeitem.h"
+#include "../core/treemodel.h"
 
 class ADTToolObjectHelperPrivate;
 
@@ -14,13 +15,17 @@ class ADTToolObjectHelper : public QObject
 public:
     Q_OBJECT
 public:
-    ADTToolObjectHelper(TreeItem *item);
+    // Tests of the tool are fetched from the model when they are requested first
+    ADTToolObjectHelper(TreeModel *model, TreeItem *item);
     ~ADTToolObjectHelper();
 
     QString getId();
     ADTExecutable *getToolTask();
 
     std::vector<ADTExecutable *> getAllTasks();
+
+    // Tests which are already fetched, nothing is fetched for a tool which wasn't opened or run
+    std::vector<ADTExecutable *> getFetchedTasks();
     std::vector<ADTExecutable *> getFilteredTasks();
     ADTExecutable *getTestTask(QString test);
 
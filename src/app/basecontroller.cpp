@@ -1,6 +1,11 @@
 #include "basecontroller.h"
 
-void BaseController::buildToolHelpers(TreeModel *model, std::vector<std::unique_ptr<ADTToolObjectHelper>> &helpers)
+#include <algorithm>
+#include <QStandardPaths>
+
+void BaseController::buildToolHelpers(TreeModel *model,
+                                      std::vector<std::unique_ptr<ADTToolObjectHelper>> &helpers,
+                                      int firstTool)
 {
     std::vector<std::unique_ptr<ADTToolObjectHelper>> newHelpers;
 
@@ -9,10 +14,10 @@ void BaseController::buildToolHelpers(TreeModel *model, std::vector<std::unique_
 
     int numTools = rootItem->childCount();
 
-    for (int i = 0; i < numTools; ++i)
+    for (int i = firstTool; i < numTools; ++i)
     {
         TreeItem *tool                                 = rootItem->child(i);
-        std::unique_ptr<ADTToolObjectHelper> newHelper = std::make_unique<ADTToolObjectHelper>(tool);
+        std::unique_ptr<ADTToolObjectHelper> newHelper = std::make_unique<ADTToolObjectHelper>(model, tool);
         newHelpers.push_back(std::move(newHelper));
     }
 
@@ -21,6 +26,113 @@ void BaseController::buildToolHelpers(TreeModel *model, std::vector<std::unique_
     });
 }
 
+std::unique_ptr<ADTResultCache> BaseController::buildResultCache(ADTSettingsInterface *settings,
+                                                                 CommandLineOptions *options)
+{
+    if (options->noResultCache || !(options->useResultCache || settings->getResultCacheEnabled()))
+    {
+        return nullptr;
+    }
+
+    int ttl = options->resultCacheTtl > 0 ? options->resultCacheTtl : settings->getResultCacheTtl();
+
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/results";
+
+    return std::make_unique<ADTResultCache>(cacheDir, ttl);
+}
+
+std::unique_ptr<ADTRunHistory> BaseController::buildRunHistory(QString subdirectory)
+{
+    QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+
+    if (!subdirectory.isEmpty())
+    {
+        directory += "/" + ADTOutputSink::getSafeFileName(subdirectory);
+    }
+
+    return std::make_unique<ADTRunHistory>(directory + "/history.json");
+}
+
+std::unique_ptr<ADTAdmissionControl> BaseController::buildAdmissionControl(ADTSettingsInterface *settings,
+                                                                           CommandLineOptions *options)
+{
+    int slots = options->hostSlots >= 0 ? options->hostSlots : settings->getHostSlots();
+
+    if (slots <= 0)
+    {
+        return nullptr;
+    }
+
+    return std::make_unique<ADTAdmissionControl>(slots);
+}
+
+std::unique_ptr<ADTIdleMonitor> BaseController::buildIdleMonitor(CommandLineOptions *options)
+{
+    if (!options->background)
+    {
+        return nullptr;
+    }
+
+    ADTIdleMonitor::lowerOwnPriority();
+
+    return std::make_unique<ADTIdleMonitor>();
+}
+
+std::unique_ptr<ADTLineClassifier> BaseController::buildLineClassifier(ADTSettingsInterface *settings)
+{
+    return std::make_unique<ADTLineClassifier>(settings->getErrorPatterns(), settings->getWarningPatterns());
+}
+
+void BaseController::setupScheduling(ADTExecutor *executor, CommandLineOptions *options)
+{
+    executor->setMaxConcurrentTasks(options->jobs);
+
+    for (auto it = options->toolWeights.begin(); it != options->toolWeights.end(); ++it)
+    {
+        executor->setToolWeight(it.key(), it.value());
+    }
+}
+
+std::unique_ptr<ADTOutputSink> BaseController::buildOutputSink(ADTSettingsInterface *settings,
+                                                               CommandLineOptions *options,
+                                                               QString subdirectory)
+{
+    QString directory = !options->outputDir.isEmpty() ? options->outputDir : settings->getOutputDirectory();
+
+    if (directory.isEmpty())
+    {
+        return nullptr;
+    }
+
+    if (!subdirectory.isEmpty())
+    {
+        directory += "/" + ADTOutputSink::getSafeFileName(subdirectory);
+    }
+
+    return std::make_unique<ADTOutputSink>(directory);
+}
+
+void BaseController::setupOutputLimits(ADTExecutor *executor,
+                                       ADTSettingsInterface *settings,
+                                       CommandLineOptions *options)
+{
+    int head = options->outputHead >= 0 ? options->outputHead : settings->getOutputHeadLimit();
+    int tail = options->outputTail >= 0 ? options->outputTail : settings->getOutputTailLimit();
+
+    executor->setOutputLimits(static_cast<qint64>(std::max(head, 0)) * 1024,
+                              static_cast<qint64>(std::max(tail, 0)) * 1024);
+}
+
+QString BaseController::getSeveritySummary(ADTExecutable *task)
+{
+    if (task->getErrorCount() == 0 && task->getWarningCount() == 0)
+    {
+        return QString();
+    }
+
+    return QString(" (errors: %1, warnings: %2)").arg(task->getErrorCount()).arg(task->getWarningCount());
+}
+
 int BaseController::listObjects()
 {
     return 0;
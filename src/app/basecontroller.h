@@ -2,8 +2,13 @@
 #define BASECONTROLLER_H
 
 #include "../core/treemodel.h"
+#include "adtexecutor.h"
+#include "adtresultcache.h"
+#include "adtrunhistory.h"
 #include "adttoolobjecthelper.h"
 #include "interfaces/appcontrollerinterface.h"
+#include "parser/commandlineoptions.h"
+#include "settings/adtsettingsinterface.h"
 #include <memory>
 #include <vector>
 
@@ -14,7 +19,32 @@ public:
     ~BaseController() = default;
 
 public:
-    void buildToolHelpers(TreeModel *model, std::vector<std::unique_ptr<ADTToolObjectHelper>> &vec);
+    // Helpers are built for tools starting from firstTool
+    void buildToolHelpers(TreeModel *model, std::vector<std::unique_ptr<ADTToolObjectHelper>> &vec, int firstTool = 0);
+
+    std::unique_ptr<ADTResultCache> buildResultCache(ADTSettingsInterface *settings, CommandLineOptions *options);
+
+    // Targets keep their histories in subdirectories, durations of tests differ between hosts
+    std::unique_ptr<ADTRunHistory> buildRunHistory(QString subdirectory = QString());
+
+    std::unique_ptr<ADTAdmissionControl> buildAdmissionControl(ADTSettingsInterface *settings,
+                                                               CommandLineOptions *options);
+
+    std::unique_ptr<ADTIdleMonitor> buildIdleMonitor(CommandLineOptions *options);
+
+    std::unique_ptr<ADTLineClassifier> buildLineClassifier(ADTSettingsInterface *settings);
+
+    void setupScheduling(ADTExecutor *executor, CommandLineOptions *options);
+
+    // Returns nullptr if output of tests isn't written to files
+    std::unique_ptr<ADTOutputSink> buildOutputSink(ADTSettingsInterface *settings,
+                                                   CommandLineOptions *options,
+                                                   QString subdirectory = QString());
+
+    void setupOutputLimits(ADTExecutor *executor, ADTSettingsInterface *settings, CommandLineOptions *options);
+
+    // Numbers of error and warning lines of the finished test, empty if there are none
+    QString getSeveritySummary(ADTExecutable *task);
 
 public:
     int listObjects() override;
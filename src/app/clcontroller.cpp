@@ -21,6 +21,7 @@
 #include "clcontroller.h"
 #include "../core/treeitem.h"
 #include "adtexecutor.h"
+#include "adtstreamwriter.h"
 
 #include <fstream>
 #include <iostream>
@@ -40,6 +41,16 @@ public:
         , m_helpers()
         , m_settings(settings)
         , m_executor(new ADTExecutor())
+        , m_resultCache(nullptr)
+        , m_runHistory(nullptr)
+        , m_admissionControl(nullptr)
+        , m_idleMonitor(nullptr)
+        , m_lineClassifier(nullptr)
+        , m_outputSink(nullptr)
+        , m_streamWriter(options->stream ? new ADTStreamWriter(stdout) : nullptr)
+        , m_skippedTasks()
+        , m_errorLines(0)
+        , m_warningLines(0)
     {}
     ~CLControllerPrivate() { delete m_executor; }
 
@@ -50,6 +61,18 @@ public:
     std::vector<std::unique_ptr<ADTToolObjectHelper>> m_helpers;
     ADTSettingsInterface *m_settings;
     ADTExecutor *m_executor;
+    std::unique_ptr<ADTResultCache> m_resultCache;
+    std::unique_ptr<ADTRunHistory> m_runHistory;
+    std::unique_ptr<ADTAdmissionControl> m_admissionControl;
+    std::unique_ptr<ADTIdleMonitor> m_idleMonitor;
+    std::unique_ptr<ADTLineClassifier> m_lineClassifier;
+    std::unique_ptr<ADTOutputSink> m_outputSink;
+    std::unique_ptr<ADTStreamWriter> m_streamWriter;
+    std::vector<ADTExecutable *> m_skippedTasks;
+
+    // Flagged lines of all tests of the run
+    quint64 m_errorLines;
+    quint64 m_warningLines;
 
 private:
     CLControllerPrivate(const CLControllerPrivate &) = delete;
@@ -67,8 +90,32 @@ CLController::CLController(TreeModel *model,
 {
     buildToolHelpers(d->m_model, d->m_helpers);
 
+    d->m_resultCache = buildResultCache(d->m_settings, d->m_options);
+    d->m_executor->setResultCache(d->m_resultCache.get());
+
+    d->m_runHistory = buildRunHistory();
+    d->m_executor->setRunHistory(d->m_runHistory.get());
+
+    d->m_admissionControl = buildAdmissionControl(d->m_settings, d->m_options);
+    d->m_executor->setAdmissionControl(d->m_admissionControl.get());
+
+    d->m_idleMonitor = buildIdleMonitor(d->m_options);
+    d->m_executor->setIdleMonitor(d->m_idleMonitor.get());
+    d->m_executor->setTimeBudget(static_cast<qint64>(d->m_options->timeBudget) * 1000);
+
+    d->m_lineClassifier = buildLineClassifier(d->m_settings);
+    d->m_executor->setLineClassifier(d->m_lineClassifier.get());
+
+    d->m_outputSink = buildOutputSink(d->m_settings, d->m_options);
+    d->m_executor->setOutputSink(d->m_outputSink.get());
+
+    setupScheduling(d->m_executor, d->m_options);
+    setupOutputLimits(d->m_executor, d->m_settings, d->m_options);
+
     connect(d->m_executor, &ADTExecutor::beginTask, this, &CLController::onBeginTask);
     connect(d->m_executor, &ADTExecutor::finishTask, this, &CLController::onFinishTask);
+    connect(d->m_executor, &ADTExecutor::skipTask, this, &CLController::onSkipTask);
+    connect(d->m_executor, &ADTExecutor::waitingForIdleHost, this, &CLController::onWaitingForIdleHost);
     connect(d->m_executor, &ADTExecutor::allTaskBegin, this, &CLController::onAllTasksBegin);
     connect(d->m_executor, &ADTExecutor::allTasksFinished, this, &CLController::onAllTasksFinished);
 }
@@ -273,23 +320,135 @@ ADTToolObjectHelper *CLController::getToolById(QString id)
     return nullptr;
 }
 
-void CLController::onAllTasksBegin() {}
+void CLController::onAllTasksBegin()
+{
+    d->m_skippedTasks.clear();
+
+    d->m_errorLines   = 0;
+    d->m_warningLines = 0;
+}
+
+void CLController::onAllTasksFinished()
+{
+    if (d->m_streamWriter)
+    {
+        d->m_streamWriter->flush();
+    }
+
+    if (d->m_executor->getAdmissionWaitTime() > 0)
+    {
+        std::cout << "Waited for free host slots: " << d->m_executor->getAdmissionWaitTime() << " ms" << std::endl;
+    }
+
+    if (d->m_outputSink && d->m_outputSink->getDroppedBytes() > 0)
+    {
+        std::cout << "Output not written to log files because the disk was too slow: "
+                  << d->m_outputSink->getDroppedBytes() << " byte(s)" << std::endl;
+    }
+
+    if (d->m_errorLines > 0 || d->m_warningLines > 0)
+    {
+        std::cout << "Flagged output lines: " << d->m_errorLines << " error(s), " << d->m_warningLines
+                  << " warning(s)" << std::endl;
+    }
+
+    if (d->m_skippedTasks.empty())
+    {
+        return;
+    }
+
+    std::cout << "Skipped due to time budget: " << d->m_skippedTasks.size() << " test(s):";
+
+    for (ADTExecutable *task : d->m_skippedTasks)
+    {
+        std::cout << " " << task->m_id.toStdString();
+    }
 
-void CLController::onAllTasksFinished() {}
+    std::cout << std::endl;
+}
 
 void CLController::onBeginTask(ADTExecutable *task)
 {
+    if (d->m_streamWriter)
+    {
+        QByteArray prefix       = "[" + task->m_toolId.toUtf8() + "/" + task->m_id.toUtf8() + "]";
+        QByteArray stdoutPrefix = prefix + "[stdout] ";
+        QByteArray stderrPrefix = prefix + "[stderr] ";
+
+        connect(task, &ADTExecutable::getStdoutLine, this, [this, stdoutPrefix](QByteArray line) {
+            d->m_streamWriter->writeLine(stdoutPrefix, line);
+        });
+        connect(task, &ADTExecutable::getStderrLine, this, [this, stderrPrefix](QByteArray line) {
+            d->m_streamWriter->writeLine(stderrPrefix, line);
+        });
+    }
+
+    // NOTE: with several jobs or streamed output results come in arbitrary order,
+    // so each of them is printed on its own line
+    if (d->m_options->jobs > 1 || d->m_streamWriter)
+    {
+        return;
+    }
+
     std::cout << "Running test: " << task->m_id.toStdString() << "...";
 }
 
 void CLController::onFinishTask(ADTExecutable *task)
 {
+    if (d->m_streamWriter)
+    {
+        // NOTE: lines which are still in the ring are printed before the result of the test
+        task->drainOutput();
+        task->disconnect(this);
+
+        d->m_streamWriter->flush();
+    }
+
+    if (d->m_options->jobs > 1 || d->m_streamWriter)
+    {
+        std::cout << task->m_toolId.toStdString() << "/" << task->m_id.toStdString() << ": ";
+    }
+
     if (task->m_exit_code == 0)
     {
-        std::cout << "OK" << std::endl;
+        std::cout << "OK";
     }
     else
     {
-        std::cout << "ERROR" << std::endl;
+        std::cout << "ERROR";
     }
+
+    if (task->m_cached)
+    {
+        std::cout << " (cached)";
+    }
+
+    std::cout << getSeveritySummary(task).toStdString();
+
+    d->m_errorLines += task->getErrorCount();
+    d->m_warningLines += task->getWarningCount();
+
+    std::cout << std::endl;
+}
+
+void CLController::onSkipTask(ADTExecutable *task)
+{
+    d->m_skippedTasks.push_back(task);
+
+    if (d->m_streamWriter)
+    {
+        d->m_streamWriter->flush();
+    }
+
+    std::cout << "Skipping test: " << task->m_id.toStdString() << std::endl;
+}
+
+void CLController::onWaitingForIdleHost(qint64 waitTime)
+{
+    if (d->m_streamWriter)
+    {
+        d->m_streamWriter->flush();
+    }
+
+    std::cout << "Waiting for the host to become idle: " << waitTime / 1000 << " s" << std::endl;
 }
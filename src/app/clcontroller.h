@@ -71,6 +71,9 @@ private slots:
     void onBeginTask(ADTExecutable *task) override;
     void onFinishTask(ADTExecutable *task) override;
 
+    void onSkipTask(ADTExecutable *task);
+    void onWaitingForIdleHost(qint64 waitTime);
+
 private:
     CLControllerPrivate *d;
 
@@ -0,0 +1,416 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "clmultitargetcontroller.h"
+#include "adtstreamwriter.h"
+
+#include <iostream>
+#include <QEventLoop>
+#include <QThread>
+
+class ADTTargetContext
+{
+public:
+    ADTTargetContext(ADTTarget target)
+        : m_target(std::move(target))
+        , m_helpers()
+        , m_executor(new ADTExecutor())
+        , m_runHistory(nullptr)
+        , m_admissionControl(nullptr)
+        , m_idleMonitor(nullptr)
+        , m_outputSink(nullptr)
+    {}
+
+    ADTToolObjectHelper *getToolById(QString id)
+    {
+        for (auto &helper : m_helpers)
+        {
+            if (helper->getId() == id)
+            {
+                return helper.get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    ADTTarget m_target;
+    std::vector<std::unique_ptr<ADTToolObjectHelper>> m_helpers;
+    std::unique_ptr<ADTExecutor> m_executor;
+    std::unique_ptr<ADTRunHistory> m_runHistory;
+    std::unique_ptr<ADTAdmissionControl> m_admissionControl;
+    std::unique_ptr<ADTIdleMonitor> m_idleMonitor;
+    std::unique_ptr<ADTOutputSink> m_outputSink;
+
+private:
+    ADTTargetContext(const ADTTargetContext &) = delete;
+    ADTTargetContext(ADTTargetContext &&)      = delete;
+    ADTTargetContext &operator=(const ADTTargetContext &) = delete;
+    ADTTargetContext &operator=(ADTTargetContext &&) = delete;
+};
+
+class CLMultiTargetControllerPrivate
+{
+public:
+    CLMultiTargetControllerPrivate(ADTSettingsInterface *settings, CommandLineOptions *options)
+        : m_options(options)
+        , m_settings(settings)
+        , m_contexts()
+        , m_lineClassifier(nullptr)
+        , m_streamWriter(options->stream ? new ADTStreamWriter(stdout) : nullptr)
+        , m_runningTargets(0)
+        , m_eventLoop()
+    {}
+    ~CLMultiTargetControllerPrivate() = default;
+
+    CommandLineOptions *m_options;
+    ADTSettingsInterface *m_settings;
+    std::vector<std::unique_ptr<ADTTargetContext>> m_contexts;
+    std::unique_ptr<ADTLineClassifier> m_lineClassifier;
+    std::unique_ptr<ADTStreamWriter> m_streamWriter;
+    int m_runningTargets;
+    QEventLoop m_eventLoop;
+
+private:
+    CLMultiTargetControllerPrivate(const CLMultiTargetControllerPrivate &) = delete;
+    CLMultiTargetControllerPrivate(CLMultiTargetControllerPrivate &&)      = delete;
+    CLMultiTargetControllerPrivate &operator=(const CLMultiTargetControllerPrivate &) = delete;
+    CLMultiTargetControllerPrivate &operator=(CLMultiTargetControllerPrivate &&) = delete;
+};
+
+CLMultiTargetController::CLMultiTargetController(std::vector<ADTTarget> targets,
+                                                 ADTSettingsInterface *settings,
+                                                 CommandLineOptions *options)
+    : d(new CLMultiTargetControllerPrivate(settings, options))
+{
+    d->m_lineClassifier = buildLineClassifier(d->m_settings);
+
+    for (ADTTarget &target : targets)
+    {
+        if (!target.model)
+        {
+            continue;
+        }
+
+        auto context = std::make_unique<ADTTargetContext>(std::move(target));
+
+        buildToolHelpers(context->m_target.model.get(), context->m_helpers);
+
+        context->m_executor->setConnection(context->m_target.connection);
+
+        context->m_executor->setLineClassifier(d->m_lineClassifier.get());
+
+        // NOTE: executors of targets run in their own threads, so each of them gets its own history,
+        // slots and idle monitor
+        context->m_runHistory = buildRunHistory(context->m_target.address);
+        context->m_executor->setRunHistory(context->m_runHistory.get());
+
+        context->m_admissionControl = buildAdmissionControl(d->m_settings, d->m_options);
+        context->m_executor->setAdmissionControl(context->m_admissionControl.get());
+
+        context->m_idleMonitor = buildIdleMonitor(d->m_options);
+        context->m_executor->setIdleMonitor(context->m_idleMonitor.get());
+        context->m_executor->setTimeBudget(static_cast<qint64>(d->m_options->timeBudget) * 1000);
+
+        // NOTE: tests of different targets have the same names, so each target has its own directory
+        context->m_outputSink = buildOutputSink(d->m_settings, d->m_options, context->m_target.address);
+        context->m_executor->setOutputSink(context->m_outputSink.get());
+
+        setupScheduling(context->m_executor.get(), d->m_options);
+        setupOutputLimits(context->m_executor.get(), d->m_settings, d->m_options);
+
+        connect(context->m_executor.get(), &ADTExecutor::beginTask, this, &CLMultiTargetController::onBeginTask);
+        connect(context->m_executor.get(), &ADTExecutor::finishTask, this, &CLMultiTargetController::onFinishTask);
+        connect(context->m_executor.get(), &ADTExecutor::skipTask, this, &CLMultiTargetController::onSkipTask);
+        connect(context->m_executor.get(),
+                &ADTExecutor::waitingForIdleHost,
+                this,
+                &CLMultiTargetController::onWaitingForIdleHost);
+        connect(context->m_executor.get(),
+                &ADTExecutor::allTasksFinished,
+                this,
+                &CLMultiTargetController::onAllTasksFinished);
+
+        d->m_contexts.push_back(std::move(context));
+    }
+}
+
+CLMultiTargetController::~CLMultiTargetController()
+{
+    delete d;
+}
+
+int CLMultiTargetController::listObjects()
+{
+    for (auto &context : d->m_contexts)
+    {
+        for (auto &helper : context->m_helpers)
+        {
+            std::cout << "[" << context->m_target.address.toStdString() << "] " << helper->getId().toStdString()
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
+
+int CLMultiTargetController::listTestsOfObject(QString object)
+{
+    int result = 0;
+
+    for (auto &context : d->m_contexts)
+    {
+        ADTToolObjectHelper *tool = context->getToolById(object);
+
+        if (!tool)
+        {
+            std::cerr << "[" << context->m_target.address.toStdString()
+                      << "] ERROR: can't find object: " << object.toStdString() << std::endl;
+            result = 1;
+            continue;
+        }
+
+        for (auto test : tool->getAllTasks())
+        {
+            std::cout << "[" << context->m_target.address.toStdString() << "] " << test->m_id.toStdString()
+                      << std::endl;
+        }
+    }
+
+    return result;
+}
+
+int CLMultiTargetController::runAllTestsOfObject(QString object)
+{
+    return runOnAllTargets(object, QString());
+}
+
+int CLMultiTargetController::runSpecifiedTestOfObject(QString object, QString test)
+{
+    return runOnAllTargets(object, test);
+}
+
+int CLMultiTargetController::runApp()
+{
+    if (d->m_contexts.empty())
+    {
+        std::cerr << "ERROR: no available targets" << std::endl;
+        return 1;
+    }
+
+    int result = -1;
+
+    switch (d->m_options->action)
+    {
+    case CommandLineOptions::Action::listOfObjects:
+        result = listObjects();
+        break;
+    case CommandLineOptions::Action::listOfTestFromSpecifiedObject:
+        result = listTestsOfObject(d->m_options->objectName);
+        break;
+    case CommandLineOptions::Action::runAllTestFromSpecifiedObject:
+        result = runAllTestsOfObject(d->m_options->objectName);
+        break;
+    case CommandLineOptions::Action::runSpecifiedTestFromSpecifiedObject:
+        result = runSpecifiedTestOfObject(d->m_options->objectName, d->m_options->testName);
+        break;
+    case CommandLineOptions::Action::getReportTool:
+        std::cerr << "ERROR: getting reports is not supported in multi-target mode" << std::endl;
+        result = 1;
+        break;
+    default:
+        break;
+    }
+
+    return result;
+}
+
+int CLMultiTargetController::runOnAllTargets(QString object, QString test)
+{
+    int result = 0;
+
+    for (auto &context : d->m_contexts)
+    {
+        std::string prefix = "[" + context->m_target.address.toStdString() + "] ";
+
+        ADTToolObjectHelper *tool = context->getToolById(object);
+
+        if (!tool)
+        {
+            std::cerr << prefix << "ERROR: can't find object: " << object.toStdString() << std::endl;
+            result = 1;
+            continue;
+        }
+
+        std::vector<ADTExecutable *> tasks;
+
+        if (test.isEmpty())
+        {
+            tasks = tool->getAllTasks();
+        }
+        else if (ADTExecutable *task = tool->getTestTask(test))
+        {
+            tasks.push_back(task);
+        }
+
+        if (tasks.empty())
+        {
+            std::cerr << prefix << "ERROR: can't find tests in object: " << object.toStdString() << std::endl;
+            result = test.isEmpty() ? 2 : 3;
+            continue;
+        }
+
+        context->m_executor->resetStopFlag();
+        context->m_executor->setTasks(tasks);
+
+        QThread *workerThread = new QThread();
+
+        connect(workerThread, &QThread::started, context->m_executor.get(), &ADTExecutor::runTasks);
+        connect(workerThread, &QThread::finished, workerThread, &QObject::deleteLater);
+
+        context->m_executor->moveToThread(workerThread);
+
+        d->m_runningTargets++;
+
+        workerThread->start();
+    }
+
+    if (d->m_runningTargets > 0)
+    {
+        d->m_eventLoop.exec();
+    }
+
+    return result;
+}
+
+QString CLMultiTargetController::getTargetPrefix(ADTExecutor *executor)
+{
+    for (auto &context : d->m_contexts)
+    {
+        if (context->m_executor.get() == executor)
+        {
+            return "[" + context->m_target.address + "] ";
+        }
+    }
+
+    return QString();
+}
+
+void CLMultiTargetController::onAllTasksFinished()
+{
+    ADTExecutor *executor = qobject_cast<ADTExecutor *>(sender());
+
+    if (d->m_streamWriter)
+    {
+        d->m_streamWriter->flush();
+    }
+
+    if (executor && executor->getAdmissionWaitTime() > 0)
+    {
+        std::cout << getTargetPrefix(executor).toStdString()
+                  << "Waited for free host slots: " << executor->getAdmissionWaitTime() << " ms" << std::endl;
+    }
+
+    for (auto &context : d->m_contexts)
+    {
+        if (context->m_executor.get() == executor && context->m_outputSink
+            && context->m_outputSink->getDroppedBytes() > 0)
+        {
+            std::cout << getTargetPrefix(executor).toStdString()
+                      << "Output not written to log files because the disk was too slow: "
+                      << context->m_outputSink->getDroppedBytes() << " byte(s)" << std::endl;
+        }
+    }
+
+    d->m_runningTargets--;
+
+    if (d->m_runningTargets <= 0)
+    {
+        d->m_eventLoop.quit();
+    }
+}
+
+void CLMultiTargetController::onBeginTask(ADTExecutable *task)
+{
+    QString prefix = getTargetPrefix(qobject_cast<ADTExecutor *>(sender()));
+
+    if (d->m_streamWriter)
+    {
+        QByteArray testPrefix   = prefix.trimmed().toUtf8() + "[" + task->m_toolId.toUtf8() + "/"
+                                + task->m_id.toUtf8() + "]";
+        QByteArray stdoutPrefix = testPrefix + "[stdout] ";
+        QByteArray stderrPrefix = testPrefix + "[stderr] ";
+
+        connect(task, &ADTExecutable::getStdoutLine, this, [this, stdoutPrefix](QByteArray line) {
+            d->m_streamWriter->writeLine(stdoutPrefix, line);
+        });
+        connect(task, &ADTExecutable::getStderrLine, this, [this, stderrPrefix](QByteArray line) {
+            d->m_streamWriter->writeLine(stderrPrefix, line);
+        });
+
+        d->m_streamWriter->flush();
+    }
+
+    std::cout << prefix.toStdString() << "Running test: " << task->m_toolId.toStdString() << "/"
+              << task->m_id.toStdString() << std::endl;
+}
+
+void CLMultiTargetController::onFinishTask(ADTExecutable *task)
+{
+    QString prefix = getTargetPrefix(qobject_cast<ADTExecutor *>(sender()));
+
+    if (d->m_streamWriter)
+    {
+        // NOTE: lines which are still in the ring are printed before the result of the test
+        task->drainOutput();
+        task->disconnect(this);
+
+        d->m_streamWriter->flush();
+    }
+
+    std::cout << prefix.toStdString() << task->m_toolId.toStdString() << "/" << task->m_id.toStdString() << ": "
+              << (task->m_exit_code == 0 ? "OK" : "ERROR") << getSeveritySummary(task).toStdString() << std::endl;
+}
+
+void CLMultiTargetController::onSkipTask(ADTExecutable *task)
+{
+    QString prefix = getTargetPrefix(qobject_cast<ADTExecutor *>(sender()));
+
+    if (d->m_streamWriter)
+    {
+        d->m_streamWriter->flush();
+    }
+
+    std::cout << prefix.toStdString() << "Skipping test: " << task->m_toolId.toStdString() << "/"
+              << task->m_id.toStdString() << std::endl;
+}
+
+void CLMultiTargetController::onWaitingForIdleHost(qint64 waitTime)
+{
+    QString prefix = getTargetPrefix(qobject_cast<ADTExecutor *>(sender()));
+
+    if (d->m_streamWriter)
+    {
+        d->m_streamWriter->flush();
+    }
+
+    std::cout << prefix.toStdString() << "Waiting for the host to become idle: " << waitTime / 1000 << " s"
+              << std::endl;
+}
@@ -0,0 +1,77 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef CLMULTITARGETCONTROLLER_H
+#define CLMULTITARGETCONTROLLER_H
+
+#include "adtexecutor.h"
+#include "adttarget.h"
+#include "basecontroller.h"
+#include "parser/commandlineoptions.h"
+#include "settings/adtsettingsinterface.h"
+
+#include <vector>
+#include <QString>
+
+class CLMultiTargetControllerPrivate;
+
+class CLMultiTargetController : public BaseController
+{
+    Q_OBJECT
+public:
+    CLMultiTargetController(std::vector<ADTTarget> targets,
+                            ADTSettingsInterface *settings,
+                            CommandLineOptions *options);
+    ~CLMultiTargetController();
+
+    int listObjects() override;
+
+    int listTestsOfObject(QString object) override;
+
+    int runAllTestsOfObject(QString object) override;
+
+    int runSpecifiedTestOfObject(QString object, QString test) override;
+
+    int runApp() override;
+
+private:
+    int runOnAllTargets(QString object, QString test);
+
+    QString getTargetPrefix(ADTExecutor *executor);
+
+private slots:
+    void onAllTasksFinished() override;
+
+    void onBeginTask(ADTExecutable *task) override;
+    void onFinishTask(ADTExecutable *task) override;
+    void onSkipTask(ADTExecutable *task);
+    void onWaitingForIdleHost(qint64 waitTime);
+
+private:
+    CLMultiTargetControllerPrivate *d;
+
+private:
+    CLMultiTargetController(const CLMultiTargetController &) = delete;
+    CLMultiTargetController(CLMultiTargetController &&)      = delete;
+    CLMultiTargetController &operator=(const CLMultiTargetController &) = delete;
+    CLMultiTargetController &operator=(CLMultiTargetController &&) = delete;
+};
+
+#endif // CLMULTITARGETCONTROLLER_H
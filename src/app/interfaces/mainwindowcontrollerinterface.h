@@ -44,6 +44,9 @@ public:
     //Details button pressed in tests widget
     virtual void detailsCurrentTest(StatusCommonWidget *widget) = 0;
 
+    //Search shortcut pressed in main window
+    virtual void searchOutput() = 0;
+
     //Runs apps with GUI or CLI
     virtual int runApp() = 0;
 
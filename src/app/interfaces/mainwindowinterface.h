@@ -16,6 +16,8 @@ public:
 
     virtual void toggleStackWidget() = 0;
 
+    virtual void showToolsWidget() = 0;
+
     virtual ToolsWidgetInterface *getToolsWidget() = 0;
 
     virtual TestWidgetInterface *getTestWidget() = 0;
@@ -22,6 +22,9 @@ public:
     virtual void showDetails(QString detailsText) = 0;
     virtual void showAllTest()                    = 0;
 
+    // Shown next to the buttons, empty text hides the summary
+    virtual void setSummary(QString text) = 0;
+
     virtual void setWidgetStatus(ADTExecutable *task, StatusCommonWidget::WidgetStatus status, bool moveScroll = true)
         = 0;
 
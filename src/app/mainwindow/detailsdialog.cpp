@@ -1,15 +1,16 @@
 #include "detailsdialog.h"
 #include "ui_detailsdialog.h"
 
-#include <QFont>
-#include <QTextCursor>
-
 DetailsDialog::DetailsDialog(QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::DetailsDialog)
+    , m_test(nullptr)
 {
     ui->setupUi(this);
     ui->closePushButton->setFocus();
+
+    updateSeverityCounts();
+    updateDroppedOutput();
 }
 
 DetailsDialog::~DetailsDialog()
@@ -19,12 +20,31 @@ DetailsDialog::~DetailsDialog()
 
 void DetailsDialog::setDetailsText(ADTExecutable *test)
 {
-    //ui->detailsPlainTextEdit->appendPlainText(test->m_log);
+    m_test = test;
+
+    ui->logView->setExecutable(test);
+
+    updateSeverityCounts();
+    updateDroppedOutput();
 }
 
 void DetailsDialog::clearDetailsText()
 {
-    ui->detailsPlainTextEdit->clear();
+    ui->logView->refresh();
+
+    updateSeverityCounts();
+    updateDroppedOutput();
+}
+
+void DetailsDialog::updateSeverityCounts()
+{
+    quint64 errors   = m_test ? m_test->getErrorCount() : 0;
+    quint64 warnings = m_test ? m_test->getWarningCount() : 0;
+
+    ui->severityLabel->setText(QString(tr("Errors: %1, warnings: %2")).arg(errors).arg(warnings));
+
+    ui->previousErrorPushButton->setEnabled(errors > 0);
+    ui->nextErrorPushButton->setEnabled(errors > 0);
 }
 
 void DetailsDialog::on_closePushButton_clicked()
@@ -32,24 +52,48 @@ void DetailsDialog::on_closePushButton_clicked()
     close();
 }
 
-void DetailsDialog::on_getStdout(QString line)
+void DetailsDialog::on_previousErrorPushButton_clicked()
+{
+    if (!m_test)
+    {
+        return;
+    }
+
+    qint64 line = m_test->m_severityIndex.findPrevious(ADTLineClassifier::Error, ui->logView->getCurrentLine());
+
+    if (line >= 0)
+    {
+        ui->logView->scrollToLine(line);
+    }
+}
+
+void DetailsDialog::on_nextErrorPushButton_clicked()
 {
-    ui->detailsPlainTextEdit->blockSignals(true);
-    QTextDocument *document = ui->detailsPlainTextEdit->document();
-    QFont font              = document->defaultFont();
-    font.setFamily("Courier New");
-    document->setDefaultFont(font);
-    ui->detailsPlainTextEdit->appendHtml("<p style=\"color:black;white-space:pre\">" + line.trimmed() + "</p>");
-    ui->detailsPlainTextEdit->blockSignals(false);
+    if (!m_test)
+    {
+        return;
+    }
+
+    qint64 line = m_test->m_severityIndex.findNext(ADTLineClassifier::Error, ui->logView->getCurrentLine() + 1);
+
+    if (line >= 0)
+    {
+        ui->logView->scrollToLine(line);
+    }
 }
 
-void DetailsDialog::on_getStderr(QString line)
+void DetailsDialog::refreshOutput()
 {
-    ui->detailsPlainTextEdit->blockSignals(true);
-    QTextDocument *document = ui->detailsPlainTextEdit->document();
-    QFont font              = document->defaultFont();
-    font.setFamily("Courier New");
-    document->setDefaultFont(font);
-    ui->detailsPlainTextEdit->appendHtml("<p style=\"color:red;white-space:pre\">" + line.trimmed() + "</p>");
-    ui->detailsPlainTextEdit->blockSignals(false);
+    // NOTE: lines are read from the log store when they become visible
+    ui->logView->refresh();
+
+    updateDroppedOutput();
+}
+
+void DetailsDialog::updateDroppedOutput()
+{
+    qint64 droppedBytes = m_test ? m_test->getDroppedOutputBytes() : 0;
+
+    ui->droppedLabel->setText(tr("... %1 byte(s) of output were dropped").arg(droppedBytes));
+    ui->droppedLabel->setVisible(droppedBytes > 0);
 }
@@ -19,16 +19,29 @@ public:
     void setDetailsText(ADTExecutable *test);
     void clearDetailsText();
 
+    // Shows numbers of flagged lines of the test and enables navigation between errors
+    void updateSeverityCounts();
+
+private:
+    // Shows how much output was dropped between the head and the tail of the log
+    void updateDroppedOutput();
+
 private slots:
     void on_closePushButton_clicked();
 
+    void on_previousErrorPushButton_clicked();
+
+    void on_nextErrorPushButton_clicked();
+
 public slots:
-    void on_getStdout(QString line);
-    void on_getStderr(QString line);
+    // Picks up new lines of the log store of the test
+    void refreshOutput();
 
 private:
     Ui::DetailsDialog *ui;
 
+    ADTExecutable *m_test;
+
 private:
     DetailsDialog(const DetailsDialog &) = delete;
     DetailsDialog(DetailsDialog &&)      = delete;
@@ -0,0 +1,199 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "logview.h"
+#include "../core/adtutf8decoder.h"
+
+#include <QFontDatabase>
+#include <QLocale>
+#include <QPainter>
+#include <QScrollBar>
+
+const int TEXT_MARGIN = 4;
+
+LogView::LogView(QWidget *parent)
+    : QAbstractScrollArea(parent)
+    , m_executable(nullptr)
+    , m_lineCount(0)
+    , m_maxLineWidth(0)
+    , m_currentLine(-1)
+{
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    viewport()->setBackgroundRole(QPalette::Base);
+    viewport()->setAutoFillBackground(true);
+}
+
+LogView::~LogView() {}
+
+void LogView::setExecutable(ADTExecutable *executable)
+{
+    m_executable   = executable;
+    m_lineCount    = 0;
+    m_maxLineWidth = 0;
+    m_currentLine  = -1;
+
+    verticalScrollBar()->setValue(0);
+    horizontalScrollBar()->setValue(0);
+
+    refresh();
+}
+
+void LogView::scrollToLine(qint64 line)
+{
+    refresh();
+
+    if (line < 0 || line >= m_lineCount)
+    {
+        return;
+    }
+
+    m_currentLine = line;
+
+    // NOTE: the line is shown in the middle of the view when possible
+    verticalScrollBar()->setValue(static_cast<int>(std::max<qint64>(0, line - getVisibleLineCount() / 2)));
+
+    viewport()->update();
+}
+
+qint64 LogView::getCurrentLine()
+{
+    return m_currentLine >= 0 ? m_currentLine : verticalScrollBar()->value();
+}
+
+void LogView::refresh()
+{
+    bool isAtBottom = verticalScrollBar()->value() == verticalScrollBar()->maximum();
+
+    // NOTE: the store is counted before the tail, lines moved from the tail meanwhile are counted once
+    qint64 lineCount = m_executable ? m_executable->m_logStore.getLineCount() + m_executable->getTailLineCount() : 0;
+
+    if (lineCount < m_lineCount)
+    {
+        // NOTE: the store was cleared
+        m_maxLineWidth = 0;
+        m_currentLine  = -1;
+    }
+
+    m_lineCount = lineCount;
+
+    updateScrollBars();
+
+    if (isAtBottom)
+    {
+        verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+    }
+
+    viewport()->update();
+}
+
+void LogView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    if (!m_executable)
+    {
+        return;
+    }
+
+    QPainter painter(viewport());
+    QFontMetrics metrics = fontMetrics();
+
+    qint64 firstLine = verticalScrollBar()->value();
+    int x            = TEXT_MARGIN - horizontalScrollBar()->value();
+    int y            = 0;
+    int maxLineWidth = m_maxLineWidth;
+
+    qint64 lineCount      = getVisibleLineCount() + 1;
+    qint64 storeLineCount = m_executable->m_logStore.getLineCount();
+
+    std::vector<ADTLogStore::Line> lines = m_executable->m_logStore.getLines(firstLine, lineCount);
+
+    if (static_cast<qint64>(lines.size()) < lineCount)
+    {
+        for (ADTLogStore::Line &line : m_executable->getTailLines(std::max<qint64>(0, firstLine - storeLineCount),
+                                                                  lineCount - static_cast<qint64>(lines.size())))
+        {
+            lines.push_back(std::move(line));
+        }
+    }
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        QString text = ADTUtf8Decoder::decode(lines[i].data);
+
+        if (firstLine + static_cast<qint64>(i) == m_currentLine)
+        {
+            painter.fillRect(0, y, viewport()->width(), metrics.lineSpacing(), palette().alternateBase());
+        }
+
+        painter.setPen(lines[i].stream == ADTLogStore::Stderr ? QColor(Qt::red) : palette().color(QPalette::Text));
+        painter.drawText(x, y + metrics.ascent(), text);
+
+        int width = metrics.horizontalAdvance(text);
+
+        if (lines[i].repeats > 1)
+        {
+            QString suffix = QString(" ") + tr("(repeated %1 times)").arg(QLocale().toString(lines[i].repeats));
+
+            painter.setPen(palette().color(QPalette::Disabled, QPalette::Text));
+            painter.drawText(x + width, y + metrics.ascent(), suffix);
+
+            width += metrics.horizontalAdvance(suffix);
+        }
+
+        maxLineWidth = std::max(maxLineWidth, width + 2 * TEXT_MARGIN);
+
+        y += metrics.lineSpacing();
+    }
+
+    if (maxLineWidth != m_maxLineWidth)
+    {
+        m_maxLineWidth = maxLineWidth;
+
+        updateScrollBars();
+    }
+}
+
+void LogView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+
+    updateScrollBars();
+}
+
+void LogView::updateScrollBars()
+{
+    int visibleLines = getVisibleLineCount();
+
+    // NOTE: the range of the scroll bar is in lines, not in pixels
+    verticalScrollBar()->setRange(0, static_cast<int>(std::max<qint64>(0, m_lineCount - visibleLines)));
+    verticalScrollBar()->setPageStep(visibleLines);
+    verticalScrollBar()->setSingleStep(1);
+
+    horizontalScrollBar()->setRange(0, std::max(0, m_maxLineWidth - viewport()->width()));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(fontMetrics().averageCharWidth());
+}
+
+int LogView::getVisibleLineCount()
+{
+    return std::max(1, viewport()->height() / fontMetrics().lineSpacing());
+}
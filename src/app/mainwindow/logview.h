@@ -0,0 +1,77 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include "../core/adtexecutable.h"
+
+#include <QAbstractScrollArea>
+
+/*
+ * Shows output of a test straight from its log store, followed by the tail of capped output
+ * which reaches the store only when the test is finished. Only visible lines are read,
+ * decoded and painted, so the view doesn't depend on the size of the output.
+ */
+class LogView : public QAbstractScrollArea
+{
+    Q_OBJECT
+public:
+    LogView(QWidget *parent = nullptr);
+    ~LogView();
+
+    void setExecutable(ADTExecutable *executable);
+
+    void scrollToLine(qint64 line);
+
+    // Highlighted line, or the first visible one if nothing is highlighted
+    qint64 getCurrentLine();
+
+public slots:
+    // Picks up new lines of the store, keeps following the end if it was shown
+    void refresh();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateScrollBars();
+    int getVisibleLineCount();
+
+private:
+    ADTExecutable *m_executable;
+
+    qint64 m_lineCount;
+
+    // Width of the longest line painted so far, px
+    int m_maxLineWidth;
+
+    // Line which is highlighted after scrollToLine, -1 if none
+    qint64 m_currentLine;
+
+private:
+    LogView(const LogView &) = delete;
+    LogView(LogView &&)      = delete;
+    LogView &operator=(const LogView &) = delete;
+    LogView &operator=(LogView &&) = delete;
+};
+
+#endif // LOGVIEW_H
@@ -114,6 +114,11 @@ void MainTestsWidget::showAllTest()
     ui->stackedWidget->setCurrentIndex(0);
 }
 
+void MainTestsWidget::setSummary(QString text)
+{
+    ui->summaryLabel->setText(text);
+}
+
 void MainTestsWidget::setWidgetStatus(ADTExecutable *task, StatusCommonWidget::WidgetStatus status, bool moveScroll)
 {
     StatusCommonWidget *currentWidget = findWidgetByTask(task);
@@ -135,7 +140,7 @@ void MainTestsWidget::on_runAllTestPushButton_clicked()
 {
     std::for_each(m_statusWidgets.begin(), m_statusWidgets.end(), [] (StatusCommonWidget *widget) {
         widget->getExecutable()->clearReports();
-        widget->getDetailsDialog()->clearDetailsText();
+        widget->clearDetails();
     });
 
     m_controller->runCurrentToolTest();
@@ -158,7 +163,7 @@ void MainTestsWidget::onRunButtonCurrentStatusWidgetClicked(StatusCommonWidget *
 
     runningTests.push_back(widget->getExecutable());
 
-    widget->getDetailsDialog()->clearDetailsText();
+    widget->clearDetails();
     m_controller->runTestsWidget(runningTests);
 }
 
@@ -179,8 +184,6 @@ void MainTestsWidget::updateStatusWidgets()
         return;
     }
 
-    m_statusWidgets.clear();
-
     std::vector<ADTExecutable *> tasks = m_helper->getFilteredTasks();
 
     if (tasks.empty())
@@ -222,6 +225,9 @@ void MainTestsWidget::updateListOfStatusCommonWidgets()
 
 void MainTestsWidget::clearUi()
 {
+    // NOTE: status widgets are children of the deleted contents widget
+    m_statusWidgets.clear();
+
     delete ui->summaryScrollAreaWidgetContents;
 
     ui->summaryScrollAreaWidgetContents = new QWidget();
@@ -266,6 +272,11 @@ void MainTestsWidget::on_exitPushButton_clicked()
 
 void MainTestsWidget::on_checkfilter_textChanged(const QString &arg1)
 {
+    if (!m_helper)
+    {
+        return;
+    }
+
     m_helper->setFilter(arg1);
 
     clearUi();
@@ -57,6 +57,8 @@ public:
 
     void showAllTest() override;
 
+    void setSummary(QString text) override;
+
     void setWidgetStatus(ADTExecutable *task, StatusCommonWidget::WidgetStatus status, bool moveScroll = true) override;
 
 private slots:
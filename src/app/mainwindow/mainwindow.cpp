@@ -22,6 +22,7 @@
 #include "./ui_mainwindow.h"
 
 #include <QDebug>
+#include <QShortcut>
 
 class MainWindowPrivate
 {
@@ -53,6 +54,14 @@ MainWindow::MainWindow(QWidget *parent)
 {
     ui->setupUi(this);
     d = new MainWindowPrivate(this, ui);
+
+    QShortcut *searchShortcut = new QShortcut(QKeySequence::Find, this);
+    connect(searchShortcut, &QShortcut::activated, this, [this]() {
+        if (d->controller)
+        {
+            d->controller->searchOutput();
+        }
+    });
 }
 
 MainWindow::~MainWindow()
@@ -79,6 +88,11 @@ void MainWindow::toggleStackWidget()
                                            : ui->stackedWidget->setCurrentIndex(0);
 }
 
+void MainWindow::showToolsWidget()
+{
+    ui->stackedWidget->setCurrentIndex(0);
+}
+
 ToolsWidgetInterface *MainWindow::getToolsWidget()
 {
     return ui->toolsPage;
@@ -48,6 +48,8 @@ public:
 
     void toggleStackWidget() override;
 
+    void showToolsWidget() override;
+
     ToolsWidgetInterface *getToolsWidget() override;
     TestWidgetInterface *getTestWidget() override;
 
@@ -0,0 +1,120 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "searchdialog.h"
+#include "ui_searchdialog.h"
+
+// NOTE: rows keep the task to remove its matches when its output is cleared
+const int TASK_ROLE = Qt::UserRole;
+
+enum ResultColumn
+{
+    TestColumn,
+    LineColumn,
+    TextColumn
+};
+
+SearchDialog::SearchDialog(QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::SearchDialog)
+    , m_search()
+    , m_tasks()
+    , m_matchCount(0)
+{
+    ui->setupUi(this);
+    ui->searchPushButton->setDefault(true);
+
+    connect(&m_search, &ADTLogSearch::matchFound, this, &SearchDialog::onMatchFound);
+    connect(&m_search, &ADTLogSearch::taskReset, this, &SearchDialog::onTaskReset);
+}
+
+SearchDialog::~SearchDialog()
+{
+    delete ui;
+}
+
+void SearchDialog::setTasks(std::vector<ADTExecutable *> tasks)
+{
+    m_search.stop();
+
+    m_tasks = tasks;
+}
+
+void SearchDialog::on_searchPushButton_clicked()
+{
+    ui->resultsTreeWidget->clear();
+    m_matchCount = 0;
+
+    if (ui->patternLineEdit->text().isEmpty())
+    {
+        m_search.stop();
+        ui->statusLabel->clear();
+        return;
+    }
+
+    if (!m_search.start(ui->patternLineEdit->text(), ui->regexCheckBox->isChecked(), m_tasks))
+    {
+        ui->statusLabel->setText(tr("Invalid regular expression"));
+        return;
+    }
+
+    updateStatus();
+}
+
+void SearchDialog::on_closePushButton_clicked()
+{
+    m_search.stop();
+    close();
+}
+
+void SearchDialog::onMatchFound(ADTExecutable *task, qint64 line, QString text)
+{
+    QTreeWidgetItem *item = new QTreeWidgetItem();
+    item->setText(TestColumn, task->m_name.trimmed());
+    item->setData(TestColumn, TASK_ROLE, QVariant::fromValue(static_cast<void *>(task)));
+    item->setData(LineColumn, Qt::DisplayRole, line + 1);
+    item->setText(TextColumn, text);
+
+    ui->resultsTreeWidget->addTopLevelItem(item);
+
+    m_matchCount++;
+    updateStatus();
+}
+
+void SearchDialog::onTaskReset(ADTExecutable *task)
+{
+    for (int i = ui->resultsTreeWidget->topLevelItemCount() - 1; i >= 0; i--)
+    {
+        QTreeWidgetItem *item = ui->resultsTreeWidget->topLevelItem(i);
+
+        if (item->data(TestColumn, TASK_ROLE).value<void *>() == task)
+        {
+            delete ui->resultsTreeWidget->takeTopLevelItem(i);
+            m_matchCount--;
+        }
+    }
+
+    updateStatus();
+}
+
+void SearchDialog::updateStatus()
+{
+    ui->statusLabel->setText(tr("Matches: %1").arg(m_matchCount));
+}
@@ -0,0 +1,69 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef SEARCHDIALOG_H
+#define SEARCHDIALOG_H
+
+#include "../adtlogsearch.h"
+
+#include <vector>
+#include <QDialog>
+
+namespace Ui
+{
+class SearchDialog;
+}
+
+class SearchDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    SearchDialog(QWidget *parent = nullptr);
+    ~SearchDialog();
+
+    void setTasks(std::vector<ADTExecutable *> tasks);
+
+private slots:
+    void on_searchPushButton_clicked();
+    void on_closePushButton_clicked();
+
+    void onMatchFound(ADTExecutable *task, qint64 line, QString text);
+    void onTaskReset(ADTExecutable *task);
+
+private:
+    void updateStatus();
+
+private:
+    Ui::SearchDialog *ui;
+
+    ADTLogSearch m_search;
+
+    std::vector<ADTExecutable *> m_tasks;
+
+    int m_matchCount;
+
+private:
+    SearchDialog(const SearchDialog &) = delete;
+    SearchDialog(SearchDialog &&)      = delete;
+    SearchDialog &operator=(const SearchDialog &) = delete;
+    SearchDialog &operator=(SearchDialog &&) = delete;
+};
+
+#endif // SEARCHDIALOG_H
@@ -29,7 +29,9 @@ StatusCommonWidget::StatusCommonWidget(ADTExecutable *exec, QWidget *parent)
     , ui(new Ui::StatusCommonWidget)
     , executable(exec)
     , detailsDialog(new DetailsDialog())
+    , outputThrottle(new ADTRefreshThrottle())
     , m_defaultColor()
+    , m_status(WidgetStatus::ready)
 
 {
     ui->setupUi(this);
@@ -47,12 +49,17 @@ StatusCommonWidget::StatusCommonWidget(ADTExecutable *exec, QWidget *parent)
             this,
             &StatusCommonWidget::on_runPushButton_clicked);
 
-    connect(executable, &ADTExecutable::getStdoutLine, detailsDialog, &DetailsDialog::on_getStdout);
-    connect(executable, &ADTExecutable::getStderrLine, detailsDialog, &DetailsDialog::on_getStderr);
+    detailsDialog->setDetailsText(executable);
+
+    connect(executable, &ADTExecutable::outputAppended, outputThrottle, &ADTRefreshThrottle::request);
+    connect(outputThrottle, &ADTRefreshThrottle::refreshRequested, detailsDialog, &DetailsDialog::refreshOutput);
+
+    connect(executable, &ADTExecutable::severityCountsChanged, this, &StatusCommonWidget::onSeverityCountsChanged);
 }
 
 StatusCommonWidget::~StatusCommonWidget()
 {
+    delete outputThrottle;
     delete detailsDialog;
     delete ui;
 }
@@ -84,6 +91,8 @@ void StatusCommonWidget::setWidgetStatus(StatusCommonWidget::WidgetStatus status
     QString text;
     QPalette pal = QPalette();
 
+    m_status = status;
+
     switch (status)
     {
     case WidgetStatus::ready:
@@ -108,6 +117,19 @@ void StatusCommonWidget::setWidgetStatus(StatusCommonWidget::WidgetStatus status
         break;
     }
 
+    if ((status == WidgetStatus::finishedOk || status == WidgetStatus::finishedFailed) && executable->m_cached)
+    {
+        text = text.trimmed() + QString(" ") + QString(tr("(cached)"));
+    }
+
+    if (status != WidgetStatus::ready && (executable->getErrorCount() > 0 || executable->getWarningCount() > 0))
+    {
+        text = text.trimmed() + QString(" ")
+               + QString(tr("(errors: %1, warnings: %2)"))
+                     .arg(executable->getErrorCount())
+                     .arg(executable->getWarningCount());
+    }
+
     QColor color(backColor.red, backColor.green, backColor.blue);
     pal.setColor(QPalette::Window, color);
     setPalette(pal);
@@ -126,6 +148,12 @@ DetailsDialog *StatusCommonWidget::getDetailsDialog()
     return detailsDialog;
 }
 
+void StatusCommonWidget::clearDetails()
+{
+    outputThrottle->discard();
+    detailsDialog->clearDetailsText();
+}
+
 void StatusCommonWidget::on_runPushButton_clicked()
 {
     emit runButtonCLicked(this);
@@ -135,3 +163,10 @@ void StatusCommonWidget::on_logsPushButton_clicked()
 {
     emit logsButtonClicked(this);
 }
+
+void StatusCommonWidget::onSeverityCountsChanged()
+{
+    setWidgetStatus(m_status);
+
+    detailsDialog->updateSeverityCounts();
+}
@@ -21,6 +21,7 @@
 #ifndef STATUSCOMMONWIDGET_H
 #define STATUSCOMMONWIDGET_H
 
+#include "../adtrefreshthrottle.h"
 #include "detailsdialog.h"
 
 #include <../core/treeitem.h>
@@ -105,6 +106,8 @@ public:
 
     DetailsDialog *getDetailsDialog();
 
+    void clearDetails();
+
 signals:
     void logsButtonClicked(StatusCommonWidget *widget);
 
@@ -115,6 +118,8 @@ private slots:
 
     void on_logsPushButton_clicked();
 
+    void onSeverityCountsChanged();
+
 private:
     Ui::StatusCommonWidget *ui;
 
@@ -122,8 +127,12 @@ private:
 
     DetailsDialog *detailsDialog;
 
+    ADTRefreshThrottle *outputThrottle;
+
     QColor m_defaultColor;
 
+    WidgetStatus m_status;
+
 private:
     StatusCommonWidget(const StatusCommonWidget &) = delete;
     StatusCommonWidget(StatusCommonWidget &&)      = delete;
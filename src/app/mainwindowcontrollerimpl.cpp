@@ -19,12 +19,15 @@
 ***********************************************************************************************************************/
 
 #include "mainwindowcontrollerimpl.h"
+#include "adtcatalogwatcher.h"
 #include "categoryproxymodel.h"
 #include "mainwindow/detailsdialog.h"
 #include "mainwindow/mainwindow.h"
+#include "mainwindow/searchdialog.h"
 #include "mainwindow/serviceunregisteredwidget.h"
 #include "treeproxymodel.h"
 
+#include <algorithm>
 #include <fstream>
 #include <QFileDialog>
 #include <QMessageBox>
@@ -50,11 +53,22 @@ public:
         , m_currentTool(nullptr)
         , m_serviceUnregisteredWidget(new ServiceUnregisteredWidget())
         , m_executor(new ADTExecutor())
+        , m_resultCache(nullptr)
+        , m_runHistory(nullptr)
+        , m_admissionControl(nullptr)
+        , m_idleMonitor(nullptr)
+        , m_lineClassifier(nullptr)
+        , m_outputSink(nullptr)
+        , m_sinkDroppedBytes(0)
         , m_workerThread(nullptr)
         , m_isWorkingThreadActive(false)
         , m_options(options)
         , m_application(app)
         , m_proxyModel(new QSortFilterProxyModel())
+        , m_searchDialog(nullptr)
+        , m_catalogWatcher(nullptr)
+        , m_addedExecutables()
+        , m_removedObjects()
 
     {
         m_mainWindow  = new MainWindow();
@@ -91,6 +105,18 @@ public:
 
     std::unique_ptr<ADTExecutor> m_executor;
 
+    std::unique_ptr<ADTResultCache> m_resultCache;
+
+    std::unique_ptr<ADTRunHistory> m_runHistory;
+
+    std::unique_ptr<ADTAdmissionControl> m_admissionControl;
+    std::unique_ptr<ADTIdleMonitor> m_idleMonitor;
+    std::unique_ptr<ADTLineClassifier> m_lineClassifier;
+    std::unique_ptr<ADTOutputSink> m_outputSink;
+
+    // Bytes dropped by the output sink before the current run
+    qint64 m_sinkDroppedBytes;
+
     QThread *m_workerThread;
 
     bool m_isWorkingThreadActive;
@@ -101,6 +127,14 @@ public:
 
     QSortFilterProxyModel *m_proxyModel;
 
+    std::unique_ptr<SearchDialog> m_searchDialog;
+
+    std::unique_ptr<ADTCatalogWatcher> m_catalogWatcher;
+
+    // Tools and D-Bus objects which aren't added to or removed from the model yet
+    std::vector<std::unique_ptr<ADTExecutable>> m_addedExecutables;
+    QStringList m_removedObjects;
+
 private:
     MainWindowControllerImplPrivate(const MainWindowControllerImplPrivate &) = delete;
     MainWindowControllerImplPrivate(MainWindowControllerImplPrivate &&)      = delete;
@@ -124,6 +158,29 @@ MainWindowControllerImpl::MainWindowControllerImpl(TreeModel *model,
 
     buildToolHelpers(d->m_model, d->m_helpers);
 
+    d->m_catalogWatcher = std::make_unique<ADTCatalogWatcher>(conn, ifaceData);
+
+    d->m_resultCache = buildResultCache(d->m_settings, d->m_options);
+    d->m_executor->setResultCache(d->m_resultCache.get());
+
+    d->m_runHistory = buildRunHistory();
+    d->m_executor->setRunHistory(d->m_runHistory.get());
+
+    d->m_admissionControl = buildAdmissionControl(d->m_settings, d->m_options);
+    d->m_executor->setAdmissionControl(d->m_admissionControl.get());
+
+    d->m_idleMonitor = buildIdleMonitor(d->m_options);
+    d->m_executor->setIdleMonitor(d->m_idleMonitor.get());
+
+    d->m_lineClassifier = buildLineClassifier(d->m_settings);
+    d->m_executor->setLineClassifier(d->m_lineClassifier.get());
+
+    d->m_outputSink = buildOutputSink(d->m_settings, d->m_options);
+    d->m_executor->setOutputSink(d->m_outputSink.get());
+
+    setupScheduling(d->m_executor.get(), d->m_options);
+    setupOutputLimits(d->m_executor.get(), d->m_settings, d->m_options);
+
     d->m_testWidget->setController(this);
 
     d->m_mainWindow->setController(this);
@@ -132,6 +189,10 @@ MainWindowControllerImpl::MainWindowControllerImpl(TreeModel *model,
     connect(d->m_executor.get(), &ADTExecutor::finishTask, this, &MainWindowControllerImpl::onFinishTask);
     connect(d->m_executor.get(), &ADTExecutor::allTaskBegin, this, &MainWindowControllerImpl::onAllTasksBegin);
     connect(d->m_executor.get(), &ADTExecutor::allTasksFinished, this, &MainWindowControllerImpl::onAllTasksFinished);
+    connect(d->m_executor.get(),
+            &ADTExecutor::waitingForIdleHost,
+            this,
+            &MainWindowControllerImpl::onWaitingForIdleHost);
 
     connect(d->m_serviceUnregisteredWidget,
             &ServiceUnregisteredWidget::closeAndExit,
@@ -141,6 +202,11 @@ MainWindowControllerImpl::MainWindowControllerImpl(TreeModel *model,
             &ServiceUnregisteredWidget::closeAll,
             this,
             &MainWindowControllerImpl::on_closeButtonPressed);
+
+    connect(d->m_catalogWatcher.get(),
+            &ADTCatalogWatcher::objectsChanged,
+            this,
+            &MainWindowControllerImpl::on_objectsChanged);
 }
 
 MainWindowControllerImpl::~MainWindowControllerImpl()
@@ -303,6 +369,27 @@ void MainWindowControllerImpl::detailsCurrentTest(StatusCommonWidget *widget)
     widget->getDetailsDialog()->show();
 }
 
+void MainWindowControllerImpl::searchOutput()
+{
+    if (!d->m_searchDialog)
+    {
+        d->m_searchDialog = std::make_unique<SearchDialog>();
+    }
+
+    std::vector<ADTExecutable *> tasks;
+
+    // NOTE: tests of tools which weren't fetched have never run, so they have no output to search
+    for (auto &helper : d->m_helpers)
+    {
+        std::vector<ADTExecutable *> toolTasks = helper->getFetchedTasks();
+        tasks.insert(tasks.end(), toolTasks.begin(), toolTasks.end());
+    }
+
+    d->m_searchDialog->setTasks(tasks);
+    d->m_searchDialog->show();
+    d->m_searchDialog->activateWindow();
+}
+
 int MainWindowControllerImpl::listObjects()
 {
     return 0;
@@ -451,6 +538,9 @@ void MainWindowControllerImpl::on_serviceRegistered()
     {
         d->m_executor->resetWaitFlag();
     }
+
+    // NOTE: objects of the manager may differ after its restart
+    d->m_catalogWatcher->check();
 }
 
 void MainWindowControllerImpl::on_serviceOwnerChanged() {}
@@ -492,6 +582,8 @@ void MainWindowControllerImpl::clearToolReports(TreeItem *item)
 void MainWindowControllerImpl::onAllTasksBegin()
 {
     d->m_isWorkingThreadActive = true;
+    d->m_sinkDroppedBytes      = d->m_outputSink ? d->m_outputSink->getDroppedBytes() : 0;
+    d->m_testWidget->setSummary(QString());
     d->m_testWidget->setEnabledRunButtonOfStatusWidgets(false);
     d->m_testWidget->disableButtons();
 }
@@ -501,6 +593,30 @@ void MainWindowControllerImpl::onAllTasksFinished()
     d->m_isWorkingThreadActive = false;
     d->m_testWidget->setEnabledRunButtonOfStatusWidgets(true);
     d->m_testWidget->enableButtons();
+
+    QStringList summary;
+
+    if (d->m_executor->getAdmissionWaitTime() > 0)
+    {
+        summary.append(tr("Waited for free host slots: %1 ms").arg(d->m_executor->getAdmissionWaitTime()));
+    }
+
+    qint64 droppedBytes = d->m_outputSink ? d->m_outputSink->getDroppedBytes() - d->m_sinkDroppedBytes : 0;
+
+    if (droppedBytes > 0)
+    {
+        summary.append(tr("Output not written to log files: %1 byte(s)").arg(droppedBytes));
+    }
+
+    d->m_testWidget->setSummary(summary.join("; "));
+
+    applyObjectChanges();
+}
+
+void MainWindowControllerImpl::onWaitingForIdleHost(qint64 waitTime)
+{
+    // NOTE: the summary is replaced when the run is finished
+    d->m_testWidget->setSummary(tr("Waiting for the host to become idle: %1 s").arg(waitTime / 1000));
 }
 
 void MainWindowControllerImpl::onBeginTask(ADTExecutable *task)
@@ -558,3 +674,81 @@ QModelIndex MainWindowControllerImpl::getToolById(QString id)
 
     return QModelIndex();
 }
+
+void MainWindowControllerImpl::updateObjects(QStringList removed, std::vector<std::unique_ptr<ADTExecutable>> added)
+{
+    for (const QString &path : removed)
+    {
+        // NOTE: tools of an object changed again before the changes are applied are replaced
+        d->m_addedExecutables.erase(std::remove_if(d->m_addedExecutables.begin(),
+                                                   d->m_addedExecutables.end(),
+                                                   [&path](std::unique_ptr<ADTExecutable> &executable) {
+                                                       return executable->m_dbusPath == path;
+                                                   }),
+                                    d->m_addedExecutables.end());
+
+        if (!d->m_removedObjects.contains(path))
+        {
+            d->m_removedObjects.append(path);
+        }
+    }
+
+    for (auto &executable : added)
+    {
+        d->m_addedExecutables.push_back(std::move(executable));
+    }
+
+    // NOTE: executables of running tests must stay alive, the changes are applied when the run finishes
+    if (!d->m_isWorkingThreadActive)
+    {
+        applyObjectChanges();
+    }
+}
+
+void MainWindowControllerImpl::on_objectsChanged(QStringList removed)
+{
+    updateObjects(removed, d->m_catalogWatcher->takeExecutables());
+}
+
+void MainWindowControllerImpl::applyObjectChanges()
+{
+    QStringList removed = d->m_removedObjects;
+
+    std::vector<std::unique_ptr<ADTExecutable>> added = std::move(d->m_addedExecutables);
+
+    d->m_removedObjects.clear();
+    d->m_addedExecutables.clear();
+
+    if (!removed.isEmpty())
+    {
+        if (d->m_currentTool && removed.contains(d->m_currentTool->getToolTask()->m_dbusPath))
+        {
+            d->m_currentTool = nullptr;
+            d->m_testWidget->setToolObjectHelper(nullptr);
+            d->m_toolsWidget->setDescription(QString());
+            d->m_toolsWidget->disableButtons();
+            d->m_mainWindow->showToolsWidget();
+        }
+
+        // NOTE: found lines may belong to tests of the removed tools
+        d->m_searchDialog.reset();
+
+        d->m_helpers.erase(std::remove_if(d->m_helpers.begin(),
+                                          d->m_helpers.end(),
+                                          [&removed](std::unique_ptr<ADTToolObjectHelper> &helper) {
+                                              return removed.contains(helper->getToolTask()->m_dbusPath);
+                                          }),
+                           d->m_helpers.end());
+
+        d->m_model->removeTools(removed);
+    }
+
+    if (!added.empty())
+    {
+        int firstTool = d->m_model->rowCount();
+
+        d->m_model->appendTools(std::move(added));
+
+        buildToolHelpers(d->m_model, d->m_helpers, firstTool);
+    }
+}
@@ -71,6 +71,8 @@ public:
 
     void detailsCurrentTest(StatusCommonWidget *widget);
 
+    void searchOutput() override;
+
     int listObjects();
     int listTestsOfObject(QString object);
     int runAllTestsOfObject(QString object);
@@ -81,6 +83,10 @@ public:
     void saveMainWindowSettings() override;
     void restoreMainWindowSettings() override;
 
+    // Replaces tools of the removed D-Bus objects with the added executables, while tests are running
+    // the changes are postponed until the run is finished
+    void updateObjects(QStringList removed, std::vector<std::unique_ptr<ADTExecutable>> added);
+
 public slots:
     virtual void on_serviceUnregistered() override;
     virtual void on_serviceRegistered() override;
@@ -93,6 +99,9 @@ private:
 
     QModelIndex getToolById(QString id);
 
+    // Removes and adds tools of the D-Bus objects changed since the previous call
+    void applyObjectChanges();
+
 private:
     MainWindowControllerImplPrivate *d;
 
@@ -106,6 +115,10 @@ private slots:
     void onCloseAndExitButtonPressed();
     void on_closeButtonPressed();
 
+    void on_objectsChanged(QStringList removed);
+
+    void onWaitingForIdleHost(qint64 waitTime);
+
 private:
     MainWindowControllerImpl(const MainWindowControllerImpl &) = delete;
     MainWindowControllerImpl(MainWindowControllerImpl &&)      = delete;
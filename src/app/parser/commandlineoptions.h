@@ -21,7 +21,9 @@
 #ifndef COMMANDLINEOPTIONS_H
 #define COMMANDLINEOPTIONS_H
 
+#include <qmap.h>
 #include <qstring.h>
+#include <qstringlist.h>
 
 class CommandLineOptions
 {
@@ -44,6 +46,39 @@ public:
     QString reportFilename{};
 
     bool useGraphic{true};
+
+    bool useResultCache{false};
+
+    bool noResultCache{false};
+
+    int resultCacheTtl{0};
+
+    QStringList busAddresses{};
+
+    int timeBudget{0};
+
+    int jobs{1};
+
+    QMap<QString, int> toolWeights{};
+
+    // -1 - not specified, 0 - unlimited
+    int hostSlots{-1};
+
+    bool background{false};
+
+    // KiB, -1 - not specified
+    int outputHead{-1};
+
+    int outputTail{-1};
+
+    // Directory of per-test output logs, empty - not written
+    QString outputDir{};
+
+    // Print output of tests while they are running
+    bool stream{false};
+
+    // Discover tools over D-Bus at startup instead of reading the catalog cache
+    bool noCatalogCache{false};
 };
 
 #endif
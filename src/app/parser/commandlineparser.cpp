@@ -96,6 +96,71 @@ CommandLineParseResult CommandLineParser::parseCommandLine(CommandLineOptions *o
                                             QObject::tr("Specifies to which file to save the report."),
                                             "file");
 
+    const QCommandLineOption useResultCacheOption(QStringList() << "cache",
+                                                  QObject::tr("Reuse results of previous runs of the same tests while "
+                                                              "the state of the system is unchanged."));
+
+    const QCommandLineOption resultCacheTtlOption(QStringList() << "cache-ttl",
+                                                  QObject::tr("Lifetime of cached results in seconds."),
+                                                  "seconds");
+
+    const QCommandLineOption noResultCacheOption(QStringList() << "no-cache",
+                                                 QObject::tr("Don't use cached results, always run tests."));
+
+    const QCommandLineOption busAddressOption(QStringList() << "b"
+                                                            << "bus",
+                                              QObject::tr("Run in multi-target mode against D-Bus address or bus "
+                                                          "socket path. May be specified several times."),
+                                              "address");
+
+    const QCommandLineOption timeBudgetOption(QStringList() << "budget",
+                                              QObject::tr("Time budget of the run in seconds. Tests which are most "
+                                                          "likely to fail are run first, the rest are skipped."),
+                                              "seconds");
+
+    const QCommandLineOption jobsOption(QStringList() << "j"
+                                                      << "jobs",
+                                        QObject::tr("Maximum number of tests running at the same time. Tests of "
+                                                    "different tools are interleaved fairly."),
+                                        "count");
+
+    const QCommandLineOption toolWeightOption(QStringList() << "tool-weight",
+                                              QObject::tr("Share of the tool in the schedule relative to other "
+                                                          "tools. May be specified several times."),
+                                              "tool=weight");
+
+    const QCommandLineOption hostSlotsOption(QStringList() << "host-slots",
+                                             QObject::tr("Maximum number of tests running at the same time by all "
+                                                         "adt processes of the host, 0 - unlimited."),
+                                             "count");
+
+    const QCommandLineOption backgroundOption(QStringList() << "background",
+                                              QObject::tr("Run with the lowest priority and start tests only while "
+                                                          "the host is idle."));
+
+    const QCommandLineOption outputHeadOption(QStringList() << "output-head",
+                                              QObject::tr("Keep only the first KiB of output of each test, the rest "
+                                                          "is dropped except for the tail."),
+                                              "KiB");
+
+    const QCommandLineOption outputTailOption(QStringList() << "output-tail",
+                                              QObject::tr("Keep the last KiB of output of each test which exceeds "
+                                                          "the head."),
+                                              "KiB");
+
+    const QCommandLineOption outputDirOption(QStringList() << "output-dir",
+                                             QObject::tr("Write output of each test to <dir>/<tool>/<test>.log as "
+                                                         "it is produced."),
+                                             "dir");
+
+    const QCommandLineOption streamOption(QStringList() << "stream"
+                                                        << "verbose",
+                                          QObject::tr("Print output of tests while they are running, each line is "
+                                                      "prefixed with [tool/test] and its stream."));
+
+    const QCommandLineOption noCatalogCacheOption(QStringList() << "no-catalog-cache",
+                                                  QObject::tr("Don't use the cache of discovered tools and tests."));
+
     d->parser->setSingleDashWordOptionMode(QCommandLineParser::ParseAsLongOptions);
     d->parser->addOption(objectListOption);
     d->parser->addOption(listOfObjectsOption);
@@ -104,6 +169,20 @@ CommandLineParseResult CommandLineParser::parseCommandLine(CommandLineOptions *o
     d->parser->addOption(useGraphicOption);
     d->parser->addOption(toolReportOption);
     d->parser->addOption(reportFilePath);
+    d->parser->addOption(useResultCacheOption);
+    d->parser->addOption(resultCacheTtlOption);
+    d->parser->addOption(noResultCacheOption);
+    d->parser->addOption(busAddressOption);
+    d->parser->addOption(timeBudgetOption);
+    d->parser->addOption(jobsOption);
+    d->parser->addOption(toolWeightOption);
+    d->parser->addOption(hostSlotsOption);
+    d->parser->addOption(backgroundOption);
+    d->parser->addOption(outputHeadOption);
+    d->parser->addOption(outputTailOption);
+    d->parser->addOption(outputDirOption);
+    d->parser->addOption(streamOption);
+    d->parser->addOption(noCatalogCacheOption);
 
     if (!d->parser->parse(d->application.arguments()))
     {
@@ -113,6 +192,107 @@ CommandLineParseResult CommandLineParser::parseCommandLine(CommandLineOptions *o
 
     options->useGraphic = false;
 
+    options->useResultCache = d->parser->isSet(useResultCacheOption);
+    options->noResultCache  = d->parser->isSet(noResultCacheOption);
+    options->background     = d->parser->isSet(backgroundOption);
+    options->outputDir      = d->parser->value(outputDirOption);
+    options->stream         = d->parser->isSet(streamOption);
+    options->noCatalogCache = d->parser->isSet(noCatalogCacheOption);
+
+    if (d->parser->isSet(resultCacheTtlOption))
+    {
+        bool isNumber           = false;
+        options->resultCacheTtl = d->parser->value(resultCacheTtlOption).toInt(&isNumber);
+
+        if (!isNumber || options->resultCacheTtl <= 0)
+        {
+            *errorMessage = QObject::tr("Bad cache lifetime: ") + d->parser->value(resultCacheTtlOption);
+            return CommandLineError;
+        }
+    }
+
+    if (d->parser->isSet(timeBudgetOption))
+    {
+        bool isNumber       = false;
+        options->timeBudget = d->parser->value(timeBudgetOption).toInt(&isNumber);
+
+        if (!isNumber || options->timeBudget <= 0)
+        {
+            *errorMessage = QObject::tr("Bad time budget: ") + d->parser->value(timeBudgetOption);
+            return CommandLineError;
+        }
+    }
+
+    if (d->parser->isSet(jobsOption))
+    {
+        bool isNumber = false;
+        options->jobs = d->parser->value(jobsOption).toInt(&isNumber);
+
+        if (!isNumber || options->jobs <= 0)
+        {
+            *errorMessage = QObject::tr("Bad number of jobs: ") + d->parser->value(jobsOption);
+            return CommandLineError;
+        }
+    }
+
+    if (d->parser->isSet(hostSlotsOption))
+    {
+        bool isNumber      = false;
+        options->hostSlots = d->parser->value(hostSlotsOption).toInt(&isNumber);
+
+        if (!isNumber || options->hostSlots < 0)
+        {
+            *errorMessage = QObject::tr("Bad number of host slots: ") + d->parser->value(hostSlotsOption);
+            return CommandLineError;
+        }
+    }
+
+    if (d->parser->isSet(outputHeadOption))
+    {
+        bool isNumber       = false;
+        options->outputHead = d->parser->value(outputHeadOption).toInt(&isNumber);
+
+        if (!isNumber || options->outputHead < 0)
+        {
+            *errorMessage = QObject::tr("Bad output head size: ") + d->parser->value(outputHeadOption);
+            return CommandLineError;
+        }
+    }
+
+    if (d->parser->isSet(outputTailOption))
+    {
+        bool isNumber       = false;
+        options->outputTail = d->parser->value(outputTailOption).toInt(&isNumber);
+
+        if (!isNumber || options->outputTail < 0)
+        {
+            *errorMessage = QObject::tr("Bad output tail size: ") + d->parser->value(outputTailOption);
+            return CommandLineError;
+        }
+    }
+
+    for (const QString &value : d->parser->values(toolWeightOption))
+    {
+        int separator = value.lastIndexOf('=');
+        bool isNumber = false;
+        int weight    = separator > 0 ? value.mid(separator + 1).toInt(&isNumber) : 0;
+
+        if (!isNumber || weight <= 0)
+        {
+            *errorMessage = QObject::tr("Bad tool weight: ") + value;
+            return CommandLineError;
+        }
+
+        options->toolWeights[value.left(separator)] = weight;
+    }
+
+    // NOTE: each option is one target, ';' separates alternative transports of one D-Bus address
+    for (const QString &address : d->parser->values(busAddressOption))
+    {
+        // NOTE: bare socket path is accepted as a shortcut for unix:path=<path>
+        options->busAddresses.append(address.startsWith('/') ? QString("unix:path=") + address : address);
+    }
+
     if (d->parser->isSet(versionOption))
     {
         return CommandLineVersionRequested;
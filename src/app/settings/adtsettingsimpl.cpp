@@ -19,6 +19,8 @@
 ***********************************************************************************************************************/
 
 #include "adtsettingsimpl.h"
+#include "../adtadmissioncontrol.h"
+#include "../../core/adtlineclassifier.h"
 
 #include <memory>
 #include <QDir>
@@ -31,6 +33,19 @@ const char *const DEFAULT_REPORT_PATH = "~";
 const char *const REPORT_FILENAME_TEMPLATE_KEY     = "defaultReportTemplate";
 const char *const DEFAULT_REPORT_FILENAME_TEMPLATE = "%name_report_%d_%m_%y.zip";
 
+const char *const RESULT_CACHE_ENABLED_KEY = "resultCacheEnabled";
+const char *const RESULT_CACHE_TTL_KEY     = "resultCacheTtl";
+const int DEFAULT_RESULT_CACHE_TTL         = 300;
+
+const char *const HOST_SLOTS_KEY = "hostSlots";
+
+const char *const ERROR_PATTERNS_KEY   = "errorPatterns";
+const char *const WARNING_PATTERNS_KEY = "warningPatterns";
+
+const char *const OUTPUT_HEAD_LIMIT_KEY = "outputHeadLimit";
+const char *const OUTPUT_TAIL_LIMIT_KEY = "outputTailLimit";
+const char *const OUTPUT_DIRECTORY_KEY  = "outputDirectory";
+
 class ADTSettingsPrivate
 {
 public:
@@ -129,3 +144,44 @@ QString ADTSettingsImpl::getReportFilenameTemplate()
     return d->m_settings.value(REPORT_FILENAME_TEMPLATE_KEY, QVariant(QString(DEFAULT_REPORT_FILENAME_TEMPLATE)))
         .toString();
 }
+
+bool ADTSettingsImpl::getResultCacheEnabled()
+{
+    return d->m_settings.value(RESULT_CACHE_ENABLED_KEY, QVariant(false)).toBool();
+}
+
+int ADTSettingsImpl::getResultCacheTtl()
+{
+    return d->m_settings.value(RESULT_CACHE_TTL_KEY, QVariant(DEFAULT_RESULT_CACHE_TTL)).toInt();
+}
+
+int ADTSettingsImpl::getHostSlots()
+{
+    return d->m_settings.value(HOST_SLOTS_KEY, QVariant(ADTAdmissionControl::DEFAULT_SLOTS)).toInt();
+}
+
+QStringList ADTSettingsImpl::getErrorPatterns()
+{
+    return d->m_settings.value(ERROR_PATTERNS_KEY, QVariant(ADTLineClassifier::DEFAULT_ERROR_PATTERNS)).toStringList();
+}
+
+QStringList ADTSettingsImpl::getWarningPatterns()
+{
+    return d->m_settings.value(WARNING_PATTERNS_KEY, QVariant(ADTLineClassifier::DEFAULT_WARNING_PATTERNS))
+        .toStringList();
+}
+
+int ADTSettingsImpl::getOutputHeadLimit()
+{
+    return d->m_settings.value(OUTPUT_HEAD_LIMIT_KEY, QVariant(0)).toInt();
+}
+
+int ADTSettingsImpl::getOutputTailLimit()
+{
+    return d->m_settings.value(OUTPUT_TAIL_LIMIT_KEY, QVariant(0)).toInt();
+}
+
+QString ADTSettingsImpl::getOutputDirectory()
+{
+    return d->m_settings.value(OUTPUT_DIRECTORY_KEY, QVariant(QString())).toString();
+}
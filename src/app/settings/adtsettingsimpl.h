@@ -40,6 +40,19 @@ public:
     void saveReportFilenameTemplate(QString templ) override;
     QString getReportFilenameTemplate() override;
 
+    bool getResultCacheEnabled() override;
+    int getResultCacheTtl() override;
+
+    int getHostSlots() override;
+
+    QStringList getErrorPatterns() override;
+    QStringList getWarningPatterns() override;
+
+    int getOutputHeadLimit() override;
+    int getOutputTailLimit() override;
+
+    QString getOutputDirectory() override;
+
 private:
     std::unique_ptr<ADTSettingsPrivate> d;
 
@@ -22,6 +22,7 @@
 #define ADTSETTINGSINTERFACE_H
 
 #include <QString>
+#include <QStringList>
 #include <QWidget>
 
 class ADTSettingsInterface
@@ -37,6 +38,21 @@ public:
 
     virtual void saveReportFilenameTemplate(QString templ) = 0;
     virtual QString getReportFilenameTemplate()            = 0;
+
+    virtual bool getResultCacheEnabled() = 0;
+    virtual int getResultCacheTtl()      = 0;
+
+    virtual int getHostSlots() = 0;
+
+    virtual QStringList getErrorPatterns()   = 0;
+    virtual QStringList getWarningPatterns() = 0;
+
+    // KiB, 0 - unlimited
+    virtual int getOutputHeadLimit() = 0;
+    virtual int getOutputTailLimit() = 0;
+
+    // Empty if output of tests isn't written to files
+    virtual QString getOutputDirectory() = 0;
 };
 
 #endif //ADTSETTINGSINTERFACE_H
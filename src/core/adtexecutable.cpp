@@ -20,8 +20,11 @@
 
 #include "adtexecutable.h"
 
+#include <algorithm>
 #include <QJsonArray>
 
+const size_t OUTPUT_RING_CAPACITY = 1024;
+
 ADTExecutable::ADTExecutable()
     : m_id()
     , m_type(-1)
@@ -32,17 +35,37 @@ ADTExecutable::ADTExecutable()
     , m_description()
     , m_args()
     , m_exit_code(-1)
+    , m_cached(false)
     , m_dbusServiceName()
     , m_dbusPath()
     , m_dbusInterfaceName()
     , m_dbusInfoMethodName()
     , m_dbusRunMethodName()
     , m_dbusReportMethodName()
-    , m_stringStdout()
-    , m_stringStderr()
-    , m_log()
-    , m_bytesStdout({})
-    , m_bytesStderr({})
+    , m_infoHash()
+    , m_logStore()
+    , m_stdoutAssembler()
+    , m_stderrAssembler()
+    , m_classifier(nullptr)
+    , m_severityIndex()
+    , m_reportedFlaggedLines(0)
+    , m_outputHeadLimit(0)
+    , m_outputTailLimit(0)
+    , m_isHeadFull(false)
+    , m_isTailStored(false)
+    , m_tailMutex()
+    , m_tailLines()
+    , m_tailBytes(0)
+    , m_droppedOutputBytes(0)
+    , m_outputSink(nullptr)
+    , m_outputFile(-1)
+    , m_outputRing(std::make_unique<ADTSpscRing<OutputLine>>(OUTPUT_RING_CAPACITY))
+    , m_drainScheduled(false)
+    , m_outputGeneration(0)
+    , m_drainedGeneration(0)
+    , m_overflowMutex()
+    , m_overflowLines()
+    , m_isOverflowing(false)
     , m_nameLocaleStorage()
     , m_descriptionLocaleStorage()
 {}
@@ -64,23 +87,299 @@ void ADTExecutable::setLocale(QString locale)
 
 void ADTExecutable::clearReports()
 {
-    m_stringStdout.clear();
-    m_stringStderr.clear();
-    m_log.clear();
-    m_bytesStdout.clear();
-    m_bytesStderr.clear();
+    m_logStore.clear();
+    m_stdoutAssembler.reset();
+    m_stderrAssembler.reset();
+    m_severityIndex.clear();
+
+    {
+        QMutexLocker locker(&m_tailMutex);
+        m_tailLines.clear();
+    }
+
+    m_isHeadFull           = false;
+    m_isTailStored         = false;
+    m_tailBytes            = 0;
+    m_droppedOutputBytes   = 0;
+
+    // NOTE: the ring, the overflow and the reported numbers of lines belong to the thread of the executable,
+    // they are reset there by the queued drain
+    m_outputGeneration++;
+
+    scheduleDrain();
+}
+
+QString ADTExecutable::getLog()
+{
+    return m_logStore.getText();
+}
+
+qint64 ADTExecutable::getDroppedOutputBytes()
+{
+    return m_droppedOutputBytes;
+}
+
+qint64 ADTExecutable::getTailLineCount() const
+{
+    QMutexLocker locker(&m_tailMutex);
+
+    return static_cast<qint64>(m_tailLines.size());
+}
+
+std::vector<ADTLogStore::Line> ADTExecutable::getTailLines(qint64 from, qint64 count) const
+{
+    QMutexLocker locker(&m_tailMutex);
+
+    std::vector<ADTLogStore::Line> lines;
+
+    for (qint64 i = std::max<qint64>(0, from); i < from + count && i < static_cast<qint64>(m_tailLines.size()); i++)
+    {
+        const std::pair<ADTLogStore::Stream, QByteArray> &line = m_tailLines[static_cast<size_t>(i)];
+
+        lines.push_back(ADTLogStore::Line{line.first, 0, 0, line.second, 1, 0});
+    }
+
+    return lines;
+}
+
+quint64 ADTExecutable::getErrorCount()
+{
+    return m_severityIndex.getCount(ADTLineClassifier::Error);
+}
+
+quint64 ADTExecutable::getWarningCount()
+{
+    return m_severityIndex.getCount(ADTLineClassifier::Warning);
+}
+
+void ADTExecutable::receiveOutput(ADTLogStore::Stream stream, const QByteArray &data)
+{
+    std::vector<QByteArray> lines;
+
+    (stream == ADTLogStore::Stderr ? m_stderrAssembler : m_stdoutAssembler).feed(data, lines);
+
+    for (const QByteArray &line : lines)
+    {
+        appendLine(stream, line);
+    }
+}
+
+void ADTExecutable::flushOutput()
+{
+    QByteArray line;
+
+    if (m_stdoutAssembler.flush(line))
+    {
+        appendLine(ADTLogStore::Stdout, line);
+    }
+
+    if (m_stderrAssembler.flush(line))
+    {
+        appendLine(ADTLogStore::Stderr, line);
+    }
+
+    storeTail();
+}
+
+void ADTExecutable::setOutputSink(ADTOutputSink *sink)
+{
+    if (m_outputSink)
+    {
+        m_outputSink->close(m_outputFile);
+    }
+
+    m_outputSink = sink;
+    m_outputFile = sink ? sink->open(m_toolId, m_id) : -1;
+}
+
+void ADTExecutable::appendLine(ADTLogStore::Stream stream, const QByteArray &line)
+{
+    if (m_outputSink)
+    {
+        m_outputSink->write(m_outputFile, line);
+    }
+
+    // NOTE: a few lines coming after the test is finished, e.g. an error of the call, are always kept
+    bool isCapped = (m_outputHeadLimit > 0 || m_outputTailLimit > 0) && !m_isTailStored;
+
+    // NOTE: a head limit of 0 means there is no head section, the whole output goes to the tail
+    if (!isCapped
+        || (!m_isHeadFull && m_outputHeadLimit > 0 && m_logStore.getSize() + line.size() + 1 <= m_outputHeadLimit))
+    {
+        storeLine(stream, line);
+    }
+    else
+    {
+        m_isHeadFull = true;
+
+        // NOTE: the tail isn't in the store until the test is finished, so its line numbers don't move.
+        // Widgets show it live after the lines of the store with getTailLines()
+        QMutexLocker locker(&m_tailMutex);
+
+        m_tailLines.emplace_back(stream, line);
+        m_tailBytes += line.size() + 1;
+
+        while (m_tailBytes > m_outputTailLimit && !m_tailLines.empty())
+        {
+            m_tailBytes -= m_tailLines.front().second.size() + 1;
+            m_droppedOutputBytes += m_tailLines.front().second.size() + 1;
+            m_tailLines.pop_front();
+        }
+    }
+
+    OutputLine item{m_outputGeneration, stream, line};
+
+    // NOTE: the receiver is never blocked by a slow consumer, a full ring puts lines to the overflow.
+    // The command line streams every line, so none of them may be dropped here
+    if (m_isOverflowing || !m_outputRing->tryPush(std::move(item)))
+    {
+        QMutexLocker locker(&m_overflowMutex);
+
+        // NOTE: the overflow may have been taken meanwhile, then the ring is used again
+        if (m_isOverflowing || !m_outputRing->tryPush(std::move(item)))
+        {
+            m_overflowLines.push_back(std::move(item));
+            m_isOverflowing = true;
+        }
+    }
+
+    scheduleDrain();
+}
+
+void ADTExecutable::scheduleDrain()
+{
+    // NOTE: only one drain request is queued at a time, so the event queue doesn't grow with the output
+    if (!m_drainScheduled.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, "drainOutput", Qt::QueuedConnection);
+    }
+}
+
+void ADTExecutable::storeLine(ADTLogStore::Stream stream, const QByteArray &line)
+{
+    m_logStore.append(stream, line + '\n');
+
+    if (m_classifier)
+    {
+        // NOTE: lines are classified once on arrival, so the viewer never rescans the log for them
+        m_severityIndex.add(m_classifier->classify(line), m_logStore.getLineCount() - 1);
+    }
+}
+
+void ADTExecutable::storeTail()
+{
+    if (!m_isHeadFull)
+    {
+        return;
+    }
+
+    if (m_droppedOutputBytes > 0)
+    {
+        storeLine(ADTLogStore::Stderr,
+                  tr("... %1 byte(s) of output were dropped").arg(m_droppedOutputBytes.load()).toUtf8());
+    }
+
+    // NOTE: the lines are moved to the store under the lock and readers count the lines of the store
+    // before they take the tail, so a line is never shown twice
+    QMutexLocker locker(&m_tailMutex);
+
+    for (const std::pair<ADTLogStore::Stream, QByteArray> &line : m_tailLines)
+    {
+        storeLine(line.first, line.second);
+    }
+
+    m_tailLines.clear();
+
+    m_tailBytes    = 0;
+    m_isTailStored = true;
+
+    scheduleDrain();
 }
 
 void ADTExecutable::getStdout(QString out)
 {
-    m_log.append(out);
-    m_stringStdout.append(out);
-    emit getStdoutLine(out);
+    receiveOutput(ADTLogStore::Stdout, out.toUtf8());
 }
 
 void ADTExecutable::getStderr(QString err)
 {
-    m_log.append(err);
-    m_stringStderr.append(err);
-    emit getStderrLine(err);
+    receiveOutput(ADTLogStore::Stderr, err.toUtf8());
+}
+
+void ADTExecutable::drainOutput()
+{
+    m_drainScheduled = false;
+
+    quint64 generation = m_outputGeneration;
+
+    if (generation != m_drainedGeneration)
+    {
+        m_drainedGeneration    = generation;
+        m_reportedFlaggedLines = 0;
+    }
+
+    OutputLine item;
+
+    while (m_outputRing->tryPop(item))
+    {
+        emitLine(item, generation);
+    }
+
+    while (true)
+    {
+        std::deque<OutputLine> overflowLines;
+
+        {
+            QMutexLocker locker(&m_overflowMutex);
+
+            if (m_overflowLines.empty())
+            {
+                m_isOverflowing = false;
+                break;
+            }
+
+            overflowLines.swap(m_overflowLines);
+        }
+
+        // NOTE: while the overflow is used nothing is added to the ring, so lines left in it came before
+        while (m_outputRing->tryPop(item))
+        {
+            emitLine(item, generation);
+        }
+
+        for (const OutputLine &overflowLine : overflowLines)
+        {
+            emitLine(overflowLine, generation);
+        }
+    }
+
+    // NOTE: widgets read the lines from the log store, so nothing but the notification is sent to them
+    emit outputAppended();
+
+    quint64 flaggedLines = getErrorCount() + getWarningCount();
+
+    if (flaggedLines != m_reportedFlaggedLines)
+    {
+        m_reportedFlaggedLines = flaggedLines;
+
+        emit severityCountsChanged();
+    }
+}
+
+void ADTExecutable::emitLine(const OutputLine &item, quint64 generation)
+{
+    // NOTE: only lines of previous runs are discarded, ones of a run started after the read are kept
+    if (item.generation < generation)
+    {
+        return;
+    }
+
+    if (item.stream == ADTLogStore::Stderr)
+    {
+        emit getStderrLine(item.line);
+    }
+    else
+    {
+        emit getStdoutLine(item.line);
+    }
 }
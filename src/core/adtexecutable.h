@@ -21,7 +21,20 @@
 #ifndef ADTEXECUTABLE_H
 #define ADTEXECUTABLE_H
 
+#include "adtlineassembler.h"
+#include "adtlineclassifier.h"
+#include "adtlogstore.h"
+#include "adtoutputsink.h"
+#include "adtseverityindex.h"
+#include "adtspscring.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <QJsonObject>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 
@@ -42,7 +55,7 @@ class ADTExecutable : public QObject
     Q_PROPERTY(QString dbusInterfaceName MEMBER m_dbusInterfaceName)
     Q_PROPERTY(QString dbusRunMethodName MEMBER m_dbusServiceName)
     Q_PROPERTY(QString dbusReportMethodName MEMBER m_dbusReportMethodName)
-    Q_PROPERTY(QString log MEMBER m_log)
+    Q_PROPERTY(QString log READ getLog)
     Q_PROPERTY(int m_exit_code MEMBER m_exit_code)
 
 public:
@@ -52,6 +65,14 @@ public:
         TestType
     };
 
+    // A line on the way to the widgets, tagged with the run it belongs to
+    struct OutputLine
+    {
+        quint64 generation = 0;
+        ADTLogStore::Stream stream = ADTLogStore::Stdout;
+        QByteArray line{};
+    };
+
     QString m_id;
     int m_type;
     QString m_name;
@@ -61,6 +82,7 @@ public:
     QString m_description;
     QString m_args;
     int m_exit_code;
+    bool m_cached;
 
     QString m_dbusServiceName;
     QString m_dbusPath;
@@ -69,12 +91,51 @@ public:
     QString m_dbusRunMethodName;
     QString m_dbusReportMethodName;
 
-    QString m_stringStdout;
-    QString m_stringStderr;
-    QString m_log;
-
-    QByteArray m_bytesStdout;
-    QByteArray m_bytesStderr;
+    // Hash of the Info payload this executable was built from
+    QString m_infoHash;
+
+    ADTLogStore m_logStore;
+
+    ADTLineAssembler m_stdoutAssembler;
+    ADTLineAssembler m_stderrAssembler;
+
+    // Not owned, lines aren't classified without it
+    const ADTLineClassifier *m_classifier;
+    ADTSeverityIndex m_severityIndex;
+    // Used only in the thread of the executable
+    quint64 m_reportedFlaggedLines;
+
+    // Output kept in the store: the first head bytes and the last tail bytes, 0 and 0 - everything. The tail
+    // is added to the store only when the test is finished, getLog() doesn't contain it before that,
+    // widgets show it live with getTailLines()
+    qint64 m_outputHeadLimit;
+    qint64 m_outputTailLimit;
+    bool m_isHeadFull;
+    bool m_isTailStored;
+    // Guards the tail lines, they are read by widgets while the test is running
+    mutable QMutex m_tailMutex;
+    std::deque<std::pair<ADTLogStore::Stream, QByteArray>> m_tailLines;
+    qint64 m_tailBytes;
+    // Read by widgets while the test is running
+    std::atomic<qint64> m_droppedOutputBytes;
+
+    // Not owned, every line is written to it before the limits of the store are applied
+    ADTOutputSink *m_outputSink;
+    int m_outputFile;
+
+    // Output on the way from the receiving thread to the thread of the executable
+    std::unique_ptr<ADTSpscRing<OutputLine>> m_outputRing;
+    std::atomic<bool> m_drainScheduled;
+
+    // Incremented by clearReports(), lines of previous runs are discarded by drainOutput()
+    std::atomic<quint64> m_outputGeneration;
+    quint64 m_drainedGeneration;
+
+    // Lines which didn't fit into the ring, they are emitted after the lines in it, so no line is lost.
+    // Once a line is here the following ones come here too until the thread of the executable takes them
+    QMutex m_overflowMutex;
+    std::deque<OutputLine> m_overflowLines;
+    std::atomic<bool> m_isOverflowing;
 
     QMap<QString, QString> m_nameLocaleStorage;
     QMap<QString, QString> m_descriptionLocaleStorage;
@@ -86,13 +147,51 @@ public:
 
     void clearReports();
 
+    QString getLog();
+
+    // Bytes of output dropped between the head and the tail
+    qint64 getDroppedOutputBytes();
+
+    // Lines of the tail which isn't in the store yet, they follow the lines of the store
+    qint64 getTailLineCount() const;
+    std::vector<ADTLogStore::Line> getTailLines(qint64 from, qint64 count) const;
+
+    quint64 getErrorCount();
+    quint64 getWarningCount();
+
+    // May be called from any single thread at a time
+    void receiveOutput(ADTLogStore::Stream stream, const QByteArray &data);
+
+    // Completes the last line of each stream when the test is finished
+    void flushOutput();
+
+    // Starts a new log of the test in the sink, nullptr closes the current one
+    void setOutputSink(ADTOutputSink *sink);
+
 public slots:
     void getStdout(QString out);
     void getStderr(QString err);
 
+    // Emits lines waiting in the ring and discards ones of previous runs, called in the thread of the executable
+    void drainOutput();
+
+private:
+    void scheduleDrain();
+    void appendLine(ADTLogStore::Stream stream, const QByteArray &line);
+    void storeLine(ADTLogStore::Stream stream, const QByteArray &line);
+    void storeTail();
+    void emitLine(const OutputLine &item, quint64 generation);
+
 signals:
-    void getStdoutLine(QString);
-    void getStderrLine(QString);
+    // UTF-8 lines, they are decoded by widgets which show them
+    void getStdoutLine(QByteArray);
+    void getStderrLine(QByteArray);
+
+    // New lines were added to the log store, emitted at most once per drain of the output
+    void outputAppended();
+
+    // Numbers of flagged lines were changed, emitted at most once per drain of the output
+    void severityCountsChanged();
 };
 
 #endif //ADTEXECUTABLE_H
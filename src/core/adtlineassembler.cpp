@@ -0,0 +1,116 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtlineassembler.h"
+
+#include <cstring>
+
+const int ADTLineAssembler::MAX_LINE_LENGTH = 1024 * 1024;
+
+ADTLineAssembler::ADTLineAssembler()
+    : m_partial()
+    , m_pendingCR(false)
+{}
+
+void ADTLineAssembler::feed(const QByteArray &data, std::vector<QByteArray> &lines)
+{
+    const char *begin = data.constData();
+    int size          = data.size();
+    int pos           = 0;
+
+    if (m_pendingCR && size > 0)
+    {
+        m_pendingCR = false;
+
+        if (begin[0] == '\n')
+        {
+            lines.push_back(m_partial);
+            m_partial.clear();
+            pos = 1;
+        }
+        else
+        {
+            m_partial.clear();
+        }
+    }
+
+    while (pos < size)
+    {
+        // NOTE: memchr and memrchr are vectorized in glibc
+        const char *newline = static_cast<const char *>(memchr(begin + pos, '\n', size - pos));
+        int end             = newline ? static_cast<int>(newline - begin) : size;
+        int segmentEnd      = end;
+
+        if (segmentEnd > pos && begin[segmentEnd - 1] == '\r')
+        {
+            segmentEnd--;
+
+            if (!newline)
+            {
+                m_pendingCR = true;
+            }
+        }
+
+        const char *carriageReturn = static_cast<const char *>(memrchr(begin + pos, '\r', segmentEnd - pos));
+
+        if (carriageReturn)
+        {
+            m_partial.clear();
+            pos = static_cast<int>(carriageReturn - begin) + 1;
+        }
+
+        m_partial.append(begin + pos, segmentEnd - pos);
+
+        while (m_partial.size() > MAX_LINE_LENGTH)
+        {
+            lines.push_back(m_partial.left(MAX_LINE_LENGTH));
+            m_partial.remove(0, MAX_LINE_LENGTH);
+        }
+
+        if (newline)
+        {
+            lines.push_back(m_partial);
+            m_partial.clear();
+        }
+
+        pos = end + 1;
+    }
+}
+
+bool ADTLineAssembler::flush(QByteArray &line)
+{
+    m_pendingCR = false;
+
+    if (m_partial.isEmpty())
+    {
+        return false;
+    }
+
+    line = m_partial;
+    m_partial.clear();
+
+    return true;
+}
+
+void ADTLineAssembler::reset()
+{
+    m_partial.clear();
+    m_pendingCR = false;
+}
@@ -0,0 +1,62 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTLINEASSEMBLER_H
+#define ADTLINEASSEMBLER_H
+
+#include <vector>
+#include <QByteArray>
+
+/*
+ * Splits a stream of arbitrary output chunks into complete lines.
+ * LF and CRLF end a line, a bare CR (progress bars) starts the current line over.
+ */
+class ADTLineAssembler
+{
+public:
+    // Longer lines are split to keep memory bounded on output without newlines
+    static const int MAX_LINE_LENGTH;
+
+public:
+    ADTLineAssembler();
+    ~ADTLineAssembler() = default;
+
+    // Appends complete lines without terminators to lines
+    void feed(const QByteArray &data, std::vector<QByteArray> &lines);
+
+    // Returns false if there is no incomplete line
+    bool flush(QByteArray &line);
+
+    void reset();
+
+private:
+    QByteArray m_partial;
+
+    // The previous chunk ended with CR, its meaning depends on the next byte
+    bool m_pendingCR;
+
+private:
+    ADTLineAssembler(const ADTLineAssembler &) = delete;
+    ADTLineAssembler(ADTLineAssembler &&)      = delete;
+    ADTLineAssembler &operator=(const ADTLineAssembler &) = delete;
+    ADTLineAssembler &operator=(ADTLineAssembler &&) = delete;
+};
+
+#endif // ADTLINEASSEMBLER_H
@@ -0,0 +1,213 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtlineclassifier.h"
+
+#include <algorithm>
+#include <queue>
+
+const QStringList ADTLineClassifier::DEFAULT_ERROR_PATTERNS
+    = {"error", "fail", "fatal", "critical", "panic", "traceback", "segmentation fault"};
+const QStringList ADTLineClassifier::DEFAULT_WARNING_PATTERNS = {"warn", "deprecated"};
+
+ADTLineClassifier::ADTLineClassifier(QStringList errorPatterns, QStringList warningPatterns)
+    : m_transitions(1)
+    , m_outputs(1)
+{
+    m_transitions[0].fill(-1);
+
+    for (const QString &pattern : errorPatterns)
+    {
+        addPattern(pattern.toUtf8(), Error);
+    }
+
+    for (const QString &pattern : warningPatterns)
+    {
+        addPattern(pattern.toUtf8(), Warning);
+    }
+
+    build();
+}
+
+ADTLineClassifier::Severity ADTLineClassifier::classify(const QByteArray &line) const
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(line.constData());
+
+    Severity result = Normal;
+    int state       = 0;
+
+    for (int i = 0; i < line.size(); i++)
+    {
+        state = m_transitions[state][toLower(data[i])];
+
+        for (const Output &output : m_outputs[state])
+        {
+            if (output.severity > result && isAccepted(data, line.size(), i + 1 - output.length, i + 1))
+            {
+                result = output.severity;
+            }
+        }
+
+        if (result == Error)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+void ADTLineClassifier::addPattern(const QByteArray &pattern, Severity severity)
+{
+    if (pattern.isEmpty())
+    {
+        return;
+    }
+
+    int state = 0;
+
+    for (char byte : pattern)
+    {
+        unsigned char symbol = toLower(static_cast<unsigned char>(byte));
+
+        if (m_transitions[state][symbol] == -1)
+        {
+            m_transitions[state][symbol] = static_cast<int>(m_transitions.size());
+
+            m_transitions.emplace_back();
+            m_transitions.back().fill(-1);
+            m_outputs.emplace_back();
+        }
+
+        state = m_transitions[state][symbol];
+    }
+
+    m_outputs[state].push_back(Output{static_cast<int>(pattern.size()), severity});
+}
+
+void ADTLineClassifier::build()
+{
+    // Failure link of each state, computed breadth-first
+    std::vector<int> failures(m_transitions.size(), 0);
+    std::queue<int> states;
+
+    for (int &next : m_transitions[0])
+    {
+        if (next == -1)
+        {
+            next = 0;
+        }
+        else
+        {
+            states.push(next);
+        }
+    }
+
+    while (!states.empty())
+    {
+        int state = states.front();
+        states.pop();
+
+        // NOTE: the failure state is closer to the root, so its outputs are already complete
+        const std::vector<Output> &suffixOutputs = m_outputs[failures[state]];
+        m_outputs[state].insert(m_outputs[state].end(), suffixOutputs.begin(), suffixOutputs.end());
+
+        for (int symbol = 0; symbol < 256; symbol++)
+        {
+            int next = m_transitions[state][symbol];
+
+            if (next == -1)
+            {
+                m_transitions[state][symbol] = m_transitions[failures[state]][symbol];
+                continue;
+            }
+
+            failures[next] = m_transitions[failures[state]][symbol];
+            states.push(next);
+        }
+    }
+}
+
+bool ADTLineClassifier::isAccepted(const unsigned char *data, int size, int begin, int end)
+{
+    // NOTE: "terror" and "nonfatal" aren't errors, but "failed" and "errors" are
+    if (begin > 0 && isWordByte(data[begin]) && isWordByte(data[begin - 1]))
+    {
+        return false;
+    }
+
+    // A zero before the word: "0 errors"
+    int before = begin - 1;
+
+    while (before >= 0 && data[before] == ' ')
+    {
+        before--;
+    }
+
+    if (before < begin - 1 && before >= 0 && data[before] == '0' && (before == 0 || !isDigit(data[before - 1])))
+    {
+        return false;
+    }
+
+    // A zero after the word and a separator: "failed: 0", "errors=0"
+    int after = end;
+
+    while (after < size && isWordByte(data[after]))
+    {
+        after++;
+    }
+
+    while (after < size && data[after] == ' ')
+    {
+        after++;
+    }
+
+    if (after == size || (data[after] != ':' && data[after] != '='))
+    {
+        return true;
+    }
+
+    after++;
+
+    while (after < size && data[after] == ' ')
+    {
+        after++;
+    }
+
+    // NOTE: "error: 0x1f" and "failed: 0.5" aren't zero counts
+    return !(after < size && data[after] == '0'
+             && (after + 1 == size || (!isWordByte(data[after + 1]) && data[after + 1] != '.')));
+}
+
+bool ADTLineClassifier::isWordByte(unsigned char byte)
+{
+    // NOTE: bytes of UTF-8 sequences are taken as letters
+    return isDigit(byte) || (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || byte >= 0x80;
+}
+
+bool ADTLineClassifier::isDigit(unsigned char byte)
+{
+    return byte >= '0' && byte <= '9';
+}
+
+unsigned char ADTLineClassifier::toLower(unsigned char byte)
+{
+    return byte >= 'A' && byte <= 'Z' ? static_cast<unsigned char>(byte - 'A' + 'a') : byte;
+}
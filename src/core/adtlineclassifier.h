@@ -0,0 +1,87 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTLINECLASSIFIER_H
+#define ADTLINECLASSIFIER_H
+
+#include <array>
+#include <vector>
+#include <QByteArray>
+#include <QStringList>
+
+/*
+ * Finds the most severe of configured error and warning patterns in output lines.
+ * Patterns are matched case-insensitively (ASCII) by one pass of an Aho-Corasick automaton.
+ * A pattern matches only at the start of a word, and not in zero counts like "0 errors" or "failed: 0".
+ * The classifier isn't changed after construction and may be used from several threads.
+ */
+class ADTLineClassifier
+{
+public:
+    enum Severity
+    {
+        Normal,
+        Warning,
+        Error
+    };
+
+    static const QStringList DEFAULT_ERROR_PATTERNS;
+    static const QStringList DEFAULT_WARNING_PATTERNS;
+
+public:
+    ADTLineClassifier(QStringList errorPatterns, QStringList warningPatterns);
+    ~ADTLineClassifier() = default;
+
+    Severity classify(const QByteArray &line) const;
+
+private:
+    struct Output
+    {
+        int length;
+        Severity severity;
+    };
+
+private:
+    void addPattern(const QByteArray &pattern, Severity severity);
+    void build();
+
+    // Checks the match of [begin, end) is at the start of a word and isn't a zero count
+    static bool isAccepted(const unsigned char *data, int size, int begin, int end);
+
+    static bool isWordByte(unsigned char byte);
+    static bool isDigit(unsigned char byte);
+
+    static unsigned char toLower(unsigned char byte);
+
+private:
+    // Transitions of the automaton with failure links already resolved
+    std::vector<std::array<int, 256>> m_transitions;
+
+    // Patterns ending in the state and in its suffixes
+    std::vector<std::vector<Output>> m_outputs;
+
+private:
+    ADTLineClassifier(const ADTLineClassifier &) = delete;
+    ADTLineClassifier(ADTLineClassifier &&)      = delete;
+    ADTLineClassifier &operator=(const ADTLineClassifier &) = delete;
+    ADTLineClassifier &operator=(ADTLineClassifier &&) = delete;
+};
+
+#endif // ADTLINECLASSIFIER_H
@@ -0,0 +1,836 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtlogstore.h"
+#include "adtutf8decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <QDebug>
+#include <QDir>
+#include <QThreadPool>
+
+const int ADTLogStore::CHUNK_COALESCE_LIMIT = 64 * 1024;
+
+// NOTE: 64 KiB of index entries, about as large as a chunk
+const size_t ADTLogStore::LINE_PAGE_SIZE = 4096;
+
+const qint64 ADTLogStore::DEFAULT_MEMORY_BUDGET = 4 * 1024 * 1024;
+
+const char *const SPILL_FILE_TEMPLATE = "/adt-log-XXXXXX";
+
+// NOTE: the fastest zlib level, finished output is compressed for memory, not for storage
+const int COMPRESSION_LEVEL   = 1;
+const int MIN_COMPRESSED_SIZE = 256;
+
+ADTLogStore::ADTLogStore()
+    : m_chunks()
+    , m_nextSeq(0)
+    , m_stdoutSize(0)
+    , m_stderrSize(0)
+    , m_linePages()
+    , m_lineCount(0)
+    , m_clock()
+    , m_lastLine()
+    , m_lastStream(Stdout)
+    , m_memoryBudget(DEFAULT_MEMORY_BUDGET)
+    , m_memorySize(0)
+    , m_firstInMemory(0)
+    , m_firstPageInMemory(0)
+    , m_spillFile(nullptr)
+    , m_spillSize(0)
+    , m_spillFailed(false)
+    , m_generation(0)
+    , m_compressionJobs(0)
+    , m_compressionDone()
+    , m_mutex()
+    , m_spillMap(nullptr)
+    , m_spillMapSize(0)
+    , m_unpackedChunk(-1)
+    , m_unpackedData()
+{}
+
+ADTLogStore::~ADTLogStore()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+
+        while (m_compressionJobs > 0)
+        {
+            m_compressionDone.wait(&m_mutex);
+        }
+    }
+
+    clear();
+}
+
+void ADTLogStore::setMemoryBudget(qint64 budget)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_memoryBudget = budget;
+
+    spillChunks();
+}
+
+void ADTLogStore::append(Stream stream, const QByteArray &data)
+{
+    if (data.isEmpty())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if (stream == m_lastStream && m_lineCount > 0 && data == m_lastLine)
+    {
+        // NOTE: e.g. status lines of polling loops are kept once with the number of copies. The last line
+        // is in the last page, which is always in memory
+        std::vector<Repeat> &repeats = m_linePages.back().repeats;
+
+        if (repeats.empty() || repeats.back().line != m_lineCount - 1)
+        {
+            repeats.push_back(Repeat{m_lineCount - 1, 1, 0});
+            m_memorySize += sizeof(Repeat);
+        }
+
+        repeats.back().count++;
+        repeats.back().lastTimestamp = m_clock.nsecsElapsed();
+        return;
+    }
+
+    // NOTE: blank lines are spacing of the output, they are kept as they are instead of being collapsed
+    if (data.indexOf('\n') == data.size() - 1 && !data.trimmed().isEmpty())
+    {
+        m_lastLine   = data;
+        m_lastStream = stream;
+    }
+    else
+    {
+        m_lastLine.clear();
+    }
+
+    if (stream == Stdout)
+    {
+        m_stdoutSize += data.size();
+    }
+    else
+    {
+        m_stderrSize += data.size();
+    }
+
+    m_memorySize += data.size();
+
+    if (!m_clock.isValid())
+    {
+        m_clock.start();
+    }
+
+    qint64 position = 0;
+
+    if (!m_chunks.empty())
+    {
+        Chunk &last = m_chunks.back();
+
+        if (last.stream == stream && last.offset == -1 && !last.compressed
+            && last.size + data.size() <= CHUNK_COALESCE_LIMIT)
+        {
+            indexLines(stream, m_chunks.size() - 1, last.size, data);
+
+            last.data.append(data);
+            last.size += data.size();
+            return;
+        }
+
+        // NOTE: the chunk is sealed, give back the spare capacity of the appends
+        last.data.squeeze();
+
+        position = last.position + last.size;
+    }
+
+    m_chunks.push_back(Chunk{stream, m_nextSeq++, data, -1, data.size(), position, false});
+
+    indexLines(stream, m_chunks.size() - 1, 0, data);
+
+    spillChunks();
+}
+
+void ADTLogStore::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_spillMap)
+    {
+        m_spillFile->unmap(m_spillMap);
+    }
+
+    m_chunks.clear();
+    m_nextSeq    = 0;
+    m_stdoutSize = 0;
+    m_stderrSize = 0;
+    m_linePages.clear();
+    m_lineCount = 0;
+    m_clock.invalidate();
+    m_lastLine.clear();
+    m_memorySize        = 0;
+    m_firstInMemory     = 0;
+    m_firstPageInMemory = 0;
+    m_spillFile.reset();
+    m_spillSize    = 0;
+    m_spillFailed  = false;
+    m_spillMap     = nullptr;
+    m_spillMapSize = 0;
+
+    // NOTE: results of background compression started before are dropped
+    m_generation++;
+    m_unpackedChunk = -1;
+    m_unpackedData.clear();
+}
+
+bool ADTLogStore::isEmpty() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_chunks.empty();
+}
+
+qint64 ADTLogStore::getSize(int streams) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return (streams & Stdout ? m_stdoutSize : 0) + (streams & Stderr ? m_stderrSize : 0);
+}
+
+qint64 ADTLogStore::getMemorySize() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_memorySize;
+}
+
+void ADTLogStore::forEachChunk(int streams, std::function<void(const Chunk &)> visitor) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (size_t i = 0; i < m_chunks.size(); i++)
+    {
+        const Chunk &chunk = m_chunks[i];
+
+        if (!(chunk.stream & streams))
+        {
+            continue;
+        }
+
+        if (chunk.offset == -1 && !chunk.compressed)
+        {
+            visitor(chunk);
+            continue;
+        }
+
+        Chunk stored      = chunk;
+        stored.data       = getChunkData(i);
+        stored.compressed = false;
+
+        visitor(stored);
+    }
+}
+
+void ADTLogStore::forEachRun(int streams, std::function<void(Stream, const QByteArray &, quint64)> visitor) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    size_t repeatPage     = 0;
+    size_t repeatPosition = 0;
+    Repeat repeat{0, 1, 0};
+    bool hasRepeat = nextRepeat(repeatPage, repeatPosition, repeat);
+
+    for (size_t i = 0; i < m_chunks.size(); i++)
+    {
+        const Chunk &chunk = m_chunks[i];
+
+        if (!(chunk.stream & streams))
+        {
+            continue;
+        }
+
+        QByteArray data = getChunkData(i);
+        int position    = 0;
+
+        while (hasRepeat && getEntry(repeat.line).chunk < i)
+        {
+            hasRepeat = nextRepeat(repeatPage, repeatPosition, repeat);
+        }
+
+        while (hasRepeat && getEntry(repeat.line).chunk == i)
+        {
+            qint64 line = repeat.line;
+            int begin   = static_cast<int>(getEntry(line).offsetInChunk);
+            int end     = chunk.size;
+
+            if (line + 1 < m_lineCount && getEntry(line + 1).chunk == i)
+            {
+                end = static_cast<int>(getEntry(line + 1).offsetInChunk);
+            }
+
+            if (begin > position)
+            {
+                visitor(chunk.stream, QByteArray::fromRawData(data.constData() + position, begin - position), 1);
+            }
+
+            visitor(chunk.stream, QByteArray::fromRawData(data.constData() + begin, end - begin), repeat.count);
+
+            position  = end;
+            hasRepeat = nextRepeat(repeatPage, repeatPosition, repeat);
+        }
+
+        if (position < data.size())
+        {
+            visitor(chunk.stream, QByteArray::fromRawData(data.constData() + position, data.size() - position), 1);
+        }
+    }
+}
+
+QByteArray ADTLogStore::readAll(int streams, RepeatMode mode) const
+{
+    QByteArray result;
+    result.reserve(static_cast<int>(getSize(streams)));
+
+    forEachRun(streams, [&result, mode](Stream, const QByteArray &data, quint64 repeats) {
+        if (repeats == 1)
+        {
+            result.append(data);
+        }
+        else if (mode == CollapseRepeats)
+        {
+            result.append(data.constData(), data.endsWith('\n') ? data.size() - 1 : data.size());
+            result.append(getRepeatSuffix(repeats));
+        }
+        else
+        {
+            for (quint64 i = 0; i < repeats; i++)
+            {
+                result.append(data);
+            }
+        }
+    });
+
+    return result;
+}
+
+QString ADTLogStore::getText(int streams, RepeatMode mode) const
+{
+    return ADTUtf8Decoder::decode(readAll(streams, mode));
+}
+
+bool ADTLogStore::writeTo(QIODevice *device, int streams, RepeatMode mode) const
+{
+    bool result = true;
+
+    forEachRun(streams, [device, mode, &result](Stream, const QByteArray &data, quint64 repeats) {
+        if (!result)
+        {
+            return;
+        }
+
+        if (repeats > 1 && mode == CollapseRepeats)
+        {
+            QByteArray suffix = getRepeatSuffix(repeats);
+            int size          = data.endsWith('\n') ? data.size() - 1 : data.size();
+
+            result = device->write(data.constData(), size) == size && device->write(suffix) == suffix.size();
+            return;
+        }
+
+        for (quint64 i = 0; result && i < (mode == CollapseRepeats ? 1 : repeats); i++)
+        {
+            result = device->write(data) == data.size();
+        }
+    });
+
+    return result;
+}
+
+QByteArray ADTLogStore::getRepeatSuffix(quint64 repeats)
+{
+    return QString(" (repeated %1 times)\n").arg(repeats).toUtf8();
+}
+
+qint64 ADTLogStore::getLineCount() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_lineCount;
+}
+
+quint64 ADTLogStore::getGeneration() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_generation;
+}
+
+ADTLogStore::Line ADTLogStore::getLine(qint64 index) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return getLineLocked(index);
+}
+
+std::vector<ADTLogStore::Line> ADTLogStore::getLines(qint64 from, qint64 count) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    std::vector<Line> lines;
+
+    qint64 to = std::min(from + count, m_lineCount);
+
+    for (qint64 i = std::max<qint64>(from, 0); i < to; i++)
+    {
+        lines.push_back(getLineLocked(i));
+    }
+
+    return lines;
+}
+
+qint64 ADTLogStore::findLine(int streams, qint64 from) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (qint64 i = std::max<qint64>(from, 0); i < m_lineCount; i++)
+    {
+        if (getEntry(i).stream & streams)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool ADTLogStore::writeLinesTo(QIODevice *device, int streams, RepeatMode mode) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (qint64 i = 0; i < m_lineCount; i++)
+    {
+        if (!(getEntry(i).stream & streams))
+        {
+            continue;
+        }
+
+        Line line = getLineLocked(i);
+
+        QByteArray suffix = line.repeats > 1 && mode == CollapseRepeats ? getRepeatSuffix(line.repeats) : "\n";
+        quint64 copies    = mode == CollapseRepeats ? 1 : line.repeats;
+
+        for (quint64 copy = 0; copy < copies; copy++)
+        {
+            // NOTE: only the first and the last arrival of repeated lines are known
+            qint64 timestamp  = copy == 0 ? line.timestamp : line.lastTimestamp;
+            QByteArray prefix = QString("[%1] ").arg(timestamp / 1e9, 0, 'f', 6).toUtf8();
+
+            if (device->write(prefix) != prefix.size() || device->write(line.data) != line.data.size()
+                || device->write(suffix) != suffix.size())
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void ADTLogStore::indexLines(Stream stream, size_t chunk, int offsetInChunk, const QByteArray &data)
+{
+    qint64 timestamp = m_clock.nsecsElapsed();
+
+    // NOTE: every piece of output starts a new line, newlines inside it start more lines
+    int start = 0;
+
+    while (start < data.size())
+    {
+        LineIndexEntry entry;
+        entry.chunk         = chunk;
+        entry.offsetInChunk = static_cast<quint64>(offsetInChunk + start);
+        entry.stream        = stream;
+        entry.timestamp     = timestamp;
+
+        if (m_linePages.empty() || m_linePages.back().entries.size() == LINE_PAGE_SIZE)
+        {
+            m_linePages.push_back(LinePage{std::vector<LineIndexEntry>(), std::vector<Repeat>(), -1, 0});
+            m_linePages.back().entries.reserve(LINE_PAGE_SIZE);
+
+            m_memorySize += static_cast<qint64>(LINE_PAGE_SIZE * sizeof(LineIndexEntry));
+        }
+
+        m_linePages.back().entries.push_back(entry);
+        m_lineCount++;
+
+        int newline = data.indexOf('\n', start);
+
+        if (newline == -1)
+        {
+            break;
+        }
+
+        start = newline + 1;
+    }
+}
+
+void ADTLogStore::compressInBackground()
+{
+    QMutexLocker locker(&m_mutex);
+
+    // Index, size and data of chunks to compress
+    std::vector<std::tuple<size_t, int, QByteArray>> jobs;
+
+    for (size_t i = m_firstInMemory; i < m_chunks.size(); i++)
+    {
+        const Chunk &chunk = m_chunks[i];
+
+        if (chunk.offset == -1 && !chunk.compressed && chunk.size >= MIN_COMPRESSED_SIZE)
+        {
+            jobs.emplace_back(i, chunk.size, chunk.data);
+        }
+    }
+
+    if (jobs.empty())
+    {
+        return;
+    }
+
+    quint64 generation = m_generation;
+    m_compressionJobs++;
+
+    QThreadPool::globalInstance()->start([this, jobs, generation]() mutable {
+        for (auto &job : jobs)
+        {
+            std::get<2>(job) = qCompress(std::get<2>(job), COMPRESSION_LEVEL);
+        }
+
+        QMutexLocker locker(&m_mutex);
+
+        for (auto &job : jobs)
+        {
+            if (generation != m_generation)
+            {
+                break;
+            }
+
+            Chunk &chunk = m_chunks[std::get<0>(job)];
+
+            // NOTE: the chunk could be spilled or appended while it was compressed
+            if (chunk.offset != -1 || chunk.compressed || chunk.size != std::get<1>(job)
+                || std::get<2>(job).size() >= chunk.size)
+            {
+                continue;
+            }
+
+            m_memorySize -= chunk.size - std::get<2>(job).size();
+
+            chunk.data       = std::get<2>(job);
+            chunk.compressed = true;
+        }
+
+        m_compressionJobs--;
+        m_compressionDone.wakeAll();
+    });
+}
+
+QByteArray ADTLogStore::getChunkData(size_t index) const
+{
+    const Chunk &chunk = m_chunks[index];
+
+    if (chunk.compressed)
+    {
+        // NOTE: viewers read lines one by one, so the last unpacked chunk is kept
+        if (m_unpackedChunk != static_cast<qint64>(index))
+        {
+            m_unpackedData  = qUncompress(chunk.data);
+            m_unpackedChunk = static_cast<qint64>(index);
+        }
+
+        return m_unpackedData;
+    }
+
+    if (chunk.offset == -1)
+    {
+        return chunk.data;
+    }
+
+    const uchar *map = mapSpillFile();
+
+    if (!map)
+    {
+        return QByteArray();
+    }
+
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(map + chunk.offset), chunk.size);
+}
+
+ADTLogStore::Line ADTLogStore::getLineLocked(qint64 index) const
+{
+    if (index < 0 || index >= m_lineCount)
+    {
+        return Line{Stdout, -1, 0, QByteArray(), 1, 0};
+    }
+
+    LineIndexEntry entry = getEntry(index);
+    const Chunk &chunk   = m_chunks[entry.chunk];
+
+    int begin = static_cast<int>(entry.offsetInChunk);
+    int end   = chunk.size;
+
+    // NOTE: the line ends where the next line of the same chunk begins
+    if (index + 1 < m_lineCount)
+    {
+        LineIndexEntry next = getEntry(index + 1);
+
+        if (next.chunk == entry.chunk)
+        {
+            end = static_cast<int>(next.offsetInChunk);
+        }
+    }
+
+    QByteArray data = getChunkData(entry.chunk).mid(begin, end - begin);
+
+    if (data.endsWith('\n'))
+    {
+        data.chop(1);
+    }
+
+    Repeat repeat{index, 1, entry.timestamp};
+    findRepeat(index, repeat);
+
+    return Line{static_cast<Stream>(entry.stream),
+                chunk.position + begin,
+                entry.timestamp,
+                data,
+                repeat.count,
+                repeat.lastTimestamp};
+}
+
+ADTLogStore::LineIndexEntry ADTLogStore::getEntry(qint64 index) const
+{
+    const LinePage &page = m_linePages[static_cast<size_t>(index) / LINE_PAGE_SIZE];
+    size_t position      = static_cast<size_t>(index) % LINE_PAGE_SIZE;
+
+    if (page.offset == -1)
+    {
+        return page.entries[position];
+    }
+
+    LineIndexEntry entry{};
+
+    const uchar *map = mapSpillFile();
+
+    if (map)
+    {
+        std::memcpy(&entry, map + page.offset + position * sizeof(LineIndexEntry), sizeof(LineIndexEntry));
+    }
+
+    return entry;
+}
+
+ADTLogStore::Repeat ADTLogStore::getRepeat(const LinePage &page, size_t position) const
+{
+    if (page.offset == -1)
+    {
+        return page.repeats[position];
+    }
+
+    Repeat repeat{0, 1, 0};
+
+    const uchar *map = mapSpillFile();
+
+    if (map)
+    {
+        std::memcpy(&repeat,
+                    map + page.offset + LINE_PAGE_SIZE * sizeof(LineIndexEntry) + position * sizeof(Repeat),
+                    sizeof(Repeat));
+    }
+
+    return repeat;
+}
+
+bool ADTLogStore::findRepeat(qint64 index, Repeat &repeat) const
+{
+    const LinePage &page = m_linePages[static_cast<size_t>(index) / LINE_PAGE_SIZE];
+
+    // NOTE: repeats of a page are in the order of their lines
+    size_t first = 0;
+    size_t last  = page.offset == -1 ? page.repeats.size() : page.repeatCount;
+
+    while (first < last)
+    {
+        size_t middle  = first + (last - first) / 2;
+        Repeat current = getRepeat(page, middle);
+
+        if (current.line == index)
+        {
+            repeat = current;
+            return true;
+        }
+
+        if (current.line < index)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    return false;
+}
+
+bool ADTLogStore::nextRepeat(size_t &page, size_t &position, Repeat &repeat) const
+{
+    for (; page < m_linePages.size(); page++, position = 0)
+    {
+        const LinePage &current = m_linePages[page];
+
+        if (position < (current.offset == -1 ? current.repeats.size() : current.repeatCount))
+        {
+            repeat = getRepeat(current, position++);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ADTLogStore::spillChunks()
+{
+    // NOTE: the last chunk and the last line page may still grow, so they're always kept in memory
+    while (m_memorySize > m_memoryBudget && !m_spillFailed)
+    {
+        bool isChunk = m_firstInMemory + 1 < m_chunks.size();
+
+        if (!isChunk && m_firstPageInMemory + 1 >= m_linePages.size())
+        {
+            return;
+        }
+
+        if (isChunk ? !spillChunk(m_chunks[m_firstInMemory]) : !spillLinePage(m_linePages[m_firstPageInMemory]))
+        {
+            qWarning() << "WARNING! Can't spill test output to a temporary file, keeping it in memory";
+
+            m_spillFailed = true;
+            return;
+        }
+
+        (isChunk ? m_firstInMemory : m_firstPageInMemory)++;
+    }
+}
+
+bool ADTLogStore::spillChunk(Chunk &chunk)
+{
+    if (chunk.compressed)
+    {
+        m_memorySize += chunk.size - chunk.data.size();
+
+        chunk.data       = qUncompress(chunk.data);
+        chunk.compressed = false;
+        m_unpackedChunk  = -1;
+    }
+
+    if (!writeToSpillFile(chunk.data.constData(), chunk.size, chunk.offset))
+    {
+        return false;
+    }
+
+    chunk.data = QByteArray();
+
+    m_memorySize -= chunk.size;
+
+    return true;
+}
+
+bool ADTLogStore::spillLinePage(LinePage &page)
+{
+    // NOTE: a page before the last one is full and its lines don't get more repeats
+    QByteArray data(reinterpret_cast<const char *>(page.entries.data()),
+                    static_cast<int>(page.entries.size() * sizeof(LineIndexEntry)));
+    data.append(reinterpret_cast<const char *>(page.repeats.data()),
+                static_cast<int>(page.repeats.size() * sizeof(Repeat)));
+
+    if (!writeToSpillFile(data.constData(), data.size(), page.offset))
+    {
+        return false;
+    }
+
+    m_memorySize -= static_cast<qint64>(LINE_PAGE_SIZE * sizeof(LineIndexEntry) + page.repeats.size() * sizeof(Repeat));
+
+    page.repeatCount = page.repeats.size();
+
+    // NOTE: clear() keeps the capacity, the vectors are swapped with empty ones to free it
+    std::vector<LineIndexEntry>().swap(page.entries);
+    std::vector<Repeat>().swap(page.repeats);
+
+    return true;
+}
+
+bool ADTLogStore::writeToSpillFile(const char *data, qint64 size, qint64 &offset)
+{
+    if (!m_spillFile)
+    {
+        m_spillFile = std::make_unique<QTemporaryFile>(QDir::tempPath() + SPILL_FILE_TEMPLATE);
+
+        if (!m_spillFile->open())
+        {
+            return false;
+        }
+    }
+
+    if (!m_spillFile->seek(m_spillSize) || m_spillFile->write(data, size) != size)
+    {
+        return false;
+    }
+
+    offset = m_spillSize;
+
+    m_spillSize += size;
+
+    return true;
+}
+
+const uchar *ADTLogStore::mapSpillFile() const
+{
+    if (m_spillMap && m_spillMapSize == m_spillSize)
+    {
+        return m_spillMap;
+    }
+
+    if (m_spillMap)
+    {
+        m_spillFile->unmap(m_spillMap);
+        m_spillMap = nullptr;
+    }
+
+    m_spillFile->flush();
+
+    m_spillMap     = m_spillFile->map(0, m_spillSize);
+    m_spillMapSize = m_spillMap ? m_spillSize : 0;
+
+    return m_spillMap;
+}
@@ -0,0 +1,253 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTLOGSTORE_H
+#define ADTLOGSTORE_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QIODevice>
+#include <QMutex>
+#include <QString>
+#include <QTemporaryFile>
+#include <QWaitCondition>
+
+/*
+ * Output of a test kept once as append-only UTF-8 chunks tagged with the stream
+ * and arrival order. Merged and per-stream views are produced on demand.
+ * Chunks above the memory budget are moved to a temporary file and read back
+ * through a memory map, so memory use doesn't depend on the size of the output.
+ * Output of finished tests may be compressed in memory and unpacked on access.
+ * Every line is recorded in a side index with its stream, position and monotonic
+ * arrival time. A line which repeats the previous one is not stored again, the previous
+ * line gets a repeat count and the time of the last copy instead, blank lines aren't collapsed.
+ * The index and the repeat counts are kept in pages which count against the memory budget
+ * and are moved to the temporary file too, so memory use doesn't depend on the number of lines either.
+ * The store may be appended from one thread while other threads read it.
+ */
+class ADTLogStore
+{
+public:
+    enum Stream
+    {
+        Stdout = 0x1,
+        Stderr = 0x2,
+        All    = Stdout | Stderr
+    };
+
+    enum RepeatMode
+    {
+        // A repeated line is written once followed by the number of its copies
+        CollapseRepeats,
+        // A repeated line is written as many times as it was received
+        ExpandRepeats
+    };
+
+    struct Chunk
+    {
+        Stream stream;
+        quint64 seq;
+        QByteArray data;
+
+        // Position of the data in the spill file, -1 if the chunk is in memory
+        qint64 offset;
+        int size;
+
+        // Position of the chunk in the merged output
+        qint64 position;
+
+        // The data is compressed with qCompress, size is the size of the original data
+        bool compressed;
+    };
+
+    struct Line
+    {
+        Stream stream;
+
+        // Position of the line in the merged output
+        qint64 offset;
+
+        // Arrival time since the first output of the test, nsec
+        qint64 timestamp;
+
+        // Without the trailing newline
+        QByteArray data;
+
+        // Number of consecutive copies of the line, 1 if it isn't repeated
+        quint64 repeats;
+
+        // Arrival time of the last copy, nsec
+        qint64 lastTimestamp;
+    };
+
+    // Small consecutive pieces of the same stream are merged into one chunk up to this size
+    static const int CHUNK_COALESCE_LIMIT;
+
+    // Lines per page of the line index
+    static const size_t LINE_PAGE_SIZE;
+
+    static const qint64 DEFAULT_MEMORY_BUDGET;
+
+public:
+    ADTLogStore();
+    ~ADTLogStore();
+
+    void setMemoryBudget(qint64 budget);
+
+    void append(Stream stream, const QByteArray &data);
+    void clear();
+
+    bool isEmpty() const;
+    qint64 getSize(int streams = All) const;
+
+    qint64 getMemorySize() const;
+
+    // Calls visitor for chunks of the given streams in arrival order.
+    // NOTE: data of spilled chunks points into the map and is valid only during the call.
+    // The store is locked during the call, so the visitor must not use it
+    void forEachChunk(int streams, std::function<void(const Chunk &)> visitor) const;
+
+    // Calls visitor for output of the given streams in arrival order: pieces of chunks
+    // with repeats equal to 1 and repeated lines (with the newline) with the number of their copies.
+    // NOTE: the data is valid only during the call, the store is locked during the call
+    void forEachRun(int streams, std::function<void(Stream, const QByteArray &, quint64)> visitor) const;
+
+    QByteArray readAll(int streams = All, RepeatMode mode = ExpandRepeats) const;
+    QString getText(int streams = All, RepeatMode mode = ExpandRepeats) const;
+
+    // Writes output of the given streams piece by piece without building it in memory
+    bool writeTo(QIODevice *device, int streams = All, RepeatMode mode = ExpandRepeats) const;
+
+    qint64 getLineCount() const;
+
+    // Incremented on every clear, lines read before the change belong to the previous output
+    quint64 getGeneration() const;
+    Line getLine(qint64 index) const;
+    std::vector<Line> getLines(qint64 from, qint64 count) const;
+
+    // Returns index of the first line of the given streams at or after the index or -1
+    qint64 findLine(int streams, qint64 from = 0) const;
+
+    // Writes lines of the given streams prefixed with their arrival time in seconds
+    bool writeLinesTo(QIODevice *device, int streams = All, RepeatMode mode = ExpandRepeats) const;
+
+    // Text which follows a collapsed repeated line in exported output
+    static QByteArray getRepeatSuffix(quint64 repeats);
+
+    // Compresses chunks which are in memory in the thread pool, they are unpacked on access
+    void compressInBackground();
+
+private:
+    // 16 bytes per line
+    struct LineIndexEntry
+    {
+        quint64 chunk : 32;
+        quint64 offsetInChunk : 30;
+        quint64 stream : 2;
+        qint64 timestamp;
+    };
+
+    struct Repeat
+    {
+        qint64 line;
+        quint64 count;
+        qint64 lastTimestamp;
+    };
+
+    // Index entries of LINE_PAGE_SIZE lines and repeats of these lines in the order of the lines.
+    // A spilled page has its entries at the offset in the spill file followed by its repeats
+    struct LinePage
+    {
+        std::vector<LineIndexEntry> entries;
+        std::vector<Repeat> repeats;
+
+        // -1 if the page is in memory
+        qint64 offset;
+        size_t repeatCount;
+    };
+
+private:
+    void indexLines(Stream stream, size_t chunk, int offsetInChunk, const QByteArray &data);
+
+    LineIndexEntry getEntry(qint64 index) const;
+    Repeat getRepeat(const LinePage &page, size_t position) const;
+    bool findRepeat(qint64 index, Repeat &repeat) const;
+
+    // Moves to the repeat after the position, pages of the position are advanced across empty pages
+    bool nextRepeat(size_t &page, size_t &position, Repeat &repeat) const;
+    // NOTE: data of a spilled chunk points into the map and is valid while the store is locked
+    QByteArray getChunkData(size_t index) const;
+    Line getLineLocked(qint64 index) const;
+
+    void spillChunks();
+    bool spillChunk(Chunk &chunk);
+    bool spillLinePage(LinePage &page);
+    bool writeToSpillFile(const char *data, qint64 size, qint64 &offset);
+    const uchar *mapSpillFile() const;
+
+private:
+    std::vector<Chunk> m_chunks;
+    quint64 m_nextSeq;
+    qint64 m_stdoutSize;
+    qint64 m_stderrSize;
+
+    std::vector<LinePage> m_linePages;
+    qint64 m_lineCount;
+    QElapsedTimer m_clock;
+
+    // The last appended piece if it was one complete line, it's compared with the next one
+    QByteArray m_lastLine;
+    Stream m_lastStream;
+
+    qint64 m_memoryBudget;
+    qint64 m_memorySize;
+
+    // Index of the oldest chunk and of the oldest line page which are still in memory
+    size_t m_firstInMemory;
+    size_t m_firstPageInMemory;
+
+    std::unique_ptr<QTemporaryFile> m_spillFile;
+    qint64 m_spillSize;
+    bool m_spillFailed;
+
+    // Incremented on clear to drop results of compression of the previous output
+    quint64 m_generation;
+    int m_compressionJobs;
+    QWaitCondition m_compressionDone;
+
+    mutable QMutex m_mutex;
+
+    mutable uchar *m_spillMap;
+    mutable qint64 m_spillMapSize;
+
+    mutable qint64 m_unpackedChunk;
+    mutable QByteArray m_unpackedData;
+
+private:
+    ADTLogStore(const ADTLogStore &) = delete;
+    ADTLogStore(ADTLogStore &&)      = delete;
+    ADTLogStore &operator=(const ADTLogStore &) = delete;
+    ADTLogStore &operator=(ADTLogStore &&) = delete;
+};
+
+#endif // ADTLOGSTORE_H
@@ -0,0 +1,304 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtoutputsink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+const qint64 ADTOutputSink::MAX_PENDING_BYTES = 64 * 1024 * 1024;
+const qint64 ADTOutputSink::BATCH_BYTES       = 256 * 1024;
+const int ADTOutputSink::BATCH_INTERVAL       = 50;
+
+ADTOutputSink::ADTOutputSink(QString directory, qint64 maxPendingBytes)
+    : m_directory(std::move(directory))
+    , m_maxPendingBytes(maxPendingBytes)
+    , m_mutex()
+    , m_condition()
+    , m_requests()
+    , m_pendingBytes(0)
+    , m_droppedBytes(0)
+    , m_stopFlag(false)
+    , m_nextFile(0)
+    , m_descriptors()
+    , m_thread(QThread::create([this]() { run(); }))
+{
+    m_thread->start(QThread::LowPriority);
+}
+
+ADTOutputSink::~ADTOutputSink()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_stopFlag = true;
+        m_condition.wakeOne();
+    }
+
+    // NOTE: the writer writes everything which is queued before it exits
+    m_thread->wait();
+}
+
+int ADTOutputSink::open(const QString &tool, const QString &test)
+{
+    QString path = m_directory + "/" + getSafeFileName(tool) + "/" + getSafeFileName(test) + ".log";
+
+    int file = 0;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        file = m_nextFile++;
+    }
+
+    enqueue(Request{Request::Open, file, QFile::encodeName(path)});
+
+    return file;
+}
+
+void ADTOutputSink::write(int file, const QByteArray &line)
+{
+    enqueue(Request{Request::Write, file, line + '\n'});
+}
+
+void ADTOutputSink::close(int file)
+{
+    enqueue(Request{Request::Close, file, QByteArray()});
+}
+
+qint64 ADTOutputSink::getDroppedBytes()
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_droppedBytes;
+}
+
+QString ADTOutputSink::getSafeFileName(QString name)
+{
+    name.replace('/', '_');
+
+    if (name.isEmpty() || name == "." || name == "..")
+    {
+        name = "_" + name;
+    }
+
+    return name;
+}
+
+void ADTOutputSink::enqueue(Request request)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (request.type == Request::Write)
+    {
+        if (m_pendingBytes + request.data.size() > m_maxPendingBytes)
+        {
+            // NOTE: the caller is never blocked by a slow disk
+            m_droppedBytes += request.data.size();
+            return;
+        }
+
+        m_pendingBytes += request.data.size();
+    }
+
+    m_requests.push_back(std::move(request));
+
+    if (m_pendingBytes >= BATCH_BYTES)
+    {
+        m_condition.wakeOne();
+    }
+}
+
+void ADTOutputSink::run()
+{
+    std::vector<Request> requests;
+
+    for (;;)
+    {
+        bool isStopped    = false;
+        qint64 batchBytes = 0;
+
+        {
+            QMutexLocker locker(&m_mutex);
+
+            if (m_requests.empty() && !m_stopFlag)
+            {
+                m_condition.wait(&m_mutex, BATCH_INTERVAL);
+            }
+
+            requests.swap(m_requests);
+
+            // NOTE: all pending bytes are in the taken requests, they stay pending until they are written
+            batchBytes = m_pendingBytes;
+            isStopped  = m_stopFlag;
+        }
+
+        process(requests);
+        requests.clear();
+
+        {
+            QMutexLocker locker(&m_mutex);
+
+            m_pendingBytes -= batchBytes;
+        }
+
+        if (isStopped)
+        {
+            break;
+        }
+    }
+
+    for (auto &descriptor : m_descriptors)
+    {
+        ::close(descriptor.second);
+    }
+
+    m_descriptors.clear();
+}
+
+void ADTOutputSink::process(std::vector<Request> &requests)
+{
+    std::vector<const QByteArray *> batch;
+    int batchFile = -1;
+
+    auto flushBatch = [this, &batch, &batchFile]() {
+        auto it = m_descriptors.find(batchFile);
+
+        if (it != m_descriptors.end() && !batch.empty() && !writeBatch(it->second, batch))
+        {
+            // NOTE: the rest of the output of the test isn't written after an error
+            ::close(it->second);
+            m_descriptors.erase(it);
+        }
+
+        batch.clear();
+    };
+
+    for (const Request &request : requests)
+    {
+        if (request.type != Request::Write || request.file != batchFile)
+        {
+            flushBatch();
+            batchFile = request.file;
+        }
+
+        switch (request.type)
+        {
+        case Request::Open:
+        {
+            QString path = QFile::decodeName(request.data);
+
+            QDir().mkpath(QFileInfo(path).absolutePath());
+
+            int fd = ::open(request.data.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+            if (fd < 0)
+            {
+                qWarning() << "Can't open output log" << path << ":" << strerror(errno);
+                break;
+            }
+
+            m_descriptors[request.file] = fd;
+            break;
+        }
+        case Request::Write:
+            batch.push_back(&request.data);
+            break;
+        case Request::Close:
+        {
+            auto it = m_descriptors.find(request.file);
+
+            if (it != m_descriptors.end())
+            {
+                ::close(it->second);
+                m_descriptors.erase(it);
+            }
+
+            break;
+        }
+        }
+    }
+
+    flushBatch();
+}
+
+bool ADTOutputSink::writeBatch(int fd, const std::vector<const QByteArray *> &batch)
+{
+    std::vector<iovec> vectors;
+    vectors.reserve(std::min<size_t>(batch.size(), IOV_MAX));
+
+    size_t next = 0;
+
+    while (next < batch.size())
+    {
+        vectors.clear();
+
+        for (; next < batch.size() && vectors.size() < IOV_MAX; next++)
+        {
+            vectors.push_back(iovec{const_cast<char *>(batch[next]->constData()),
+                                    static_cast<size_t>(batch[next]->size())});
+        }
+
+        iovec *current = vectors.data();
+        int count      = static_cast<int>(vectors.size());
+
+        while (count > 0)
+        {
+            ssize_t written = ::writev(fd, current, count);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                qWarning() << "Can't write output log:" << strerror(errno);
+                return false;
+            }
+
+            // NOTE: skip vectors which are written completely and move the start of a partial one
+            while (count > 0 && static_cast<size_t>(written) >= current->iov_len)
+            {
+                written -= static_cast<ssize_t>(current->iov_len);
+                current++;
+                count--;
+            }
+
+            if (count > 0)
+            {
+                current->iov_base = static_cast<char *>(current->iov_base) + written;
+                current->iov_len -= static_cast<size_t>(written);
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,115 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTOUTPUTSINK_H
+#define ADTOUTPUTSINK_H
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+/*
+ * Writes output of tests to <dir>/<tool>/<test>.log as it is produced.
+ * Lines are queued without blocking the caller and written in batches with writev
+ * by a dedicated thread. When the disk can't keep up, lines above the queue limit
+ * are dropped and counted instead of growing memory or stalling the caller.
+ * The limit covers both queued lines and the batch which is being written.
+ */
+class ADTOutputSink
+{
+public:
+    // Default number of queued and not yet written bytes above which new lines are dropped
+    static const qint64 MAX_PENDING_BYTES;
+
+    // Queued bytes after which the writer is woken up before the interval
+    static const qint64 BATCH_BYTES;
+
+    // Interval of writing queued lines, msec
+    static const int BATCH_INTERVAL;
+
+public:
+    ADTOutputSink(QString directory, qint64 maxPendingBytes = MAX_PENDING_BYTES);
+    ~ADTOutputSink();
+
+    // Starts a new log of the test, returns its handle for write and close
+    int open(const QString &tool, const QString &test);
+    void write(int file, const QByteArray &line);
+    void close(int file);
+
+    // Bytes of lines dropped since the sink was created because the queue was full
+    qint64 getDroppedBytes();
+
+    // Replaces characters which can't be used in a file name
+    static QString getSafeFileName(QString name);
+
+private:
+    struct Request
+    {
+        enum Type
+        {
+            Open,
+            Write,
+            Close
+        };
+
+        Type type;
+        int file;
+
+        // Line to write or path of the log to open
+        QByteArray data;
+    };
+
+    void enqueue(Request request);
+
+    void run();
+    void process(std::vector<Request> &requests);
+    bool writeBatch(int fd, const std::vector<const QByteArray *> &batch);
+
+private:
+    QString m_directory;
+    qint64 m_maxPendingBytes;
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    std::vector<Request> m_requests;
+    qint64 m_pendingBytes;
+    qint64 m_droppedBytes;
+    bool m_stopFlag;
+
+    int m_nextFile;
+
+    // Descriptors of open logs, used by the writer thread only
+    std::map<int, int> m_descriptors;
+
+    std::unique_ptr<QThread> m_thread;
+
+private:
+    ADTOutputSink(const ADTOutputSink &) = delete;
+    ADTOutputSink(ADTOutputSink &&)      = delete;
+    ADTOutputSink &operator=(const ADTOutputSink &) = delete;
+    ADTOutputSink &operator=(ADTOutputSink &&) = delete;
+};
+
+#endif // ADTOUTPUTSINK_H
@@ -0,0 +1,108 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtseverityindex.h"
+
+#include <algorithm>
+#include <QMutexLocker>
+
+ADTSeverityIndex::ADTSeverityIndex()
+    : m_mutex()
+    , m_errorLines()
+    , m_warningLines()
+    , m_errorCount(0)
+    , m_warningCount(0)
+{}
+
+void ADTSeverityIndex::add(ADTLineClassifier::Severity severity, qint64 line)
+{
+    if (severity == ADTLineClassifier::Normal)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    std::vector<qint64> &lines = getLines(severity);
+
+    // NOTE: copies of a repeated line share its index, they are counted but not added again
+    if (lines.empty() || lines.back() != line)
+    {
+        lines.push_back(line);
+    }
+
+    (severity == ADTLineClassifier::Error ? m_errorCount : m_warningCount)++;
+}
+
+void ADTSeverityIndex::clear()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_errorLines.clear();
+    m_warningLines.clear();
+
+    m_errorCount   = 0;
+    m_warningCount = 0;
+}
+
+quint64 ADTSeverityIndex::getCount(ADTLineClassifier::Severity severity) const
+{
+    switch (severity)
+    {
+    case ADTLineClassifier::Error:
+        return m_errorCount;
+    case ADTLineClassifier::Warning:
+        return m_warningCount;
+    default:
+        return 0;
+    }
+}
+
+qint64 ADTSeverityIndex::findNext(ADTLineClassifier::Severity severity, qint64 from) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const std::vector<qint64> &lines = getLines(severity);
+
+    auto it = std::lower_bound(lines.begin(), lines.end(), from);
+
+    return it != lines.end() ? *it : -1;
+}
+
+qint64 ADTSeverityIndex::findPrevious(ADTLineClassifier::Severity severity, qint64 before) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    const std::vector<qint64> &lines = getLines(severity);
+
+    auto it = std::lower_bound(lines.begin(), lines.end(), before);
+
+    return it != lines.begin() ? *(it - 1) : -1;
+}
+
+std::vector<qint64> &ADTSeverityIndex::getLines(ADTLineClassifier::Severity severity)
+{
+    return severity == ADTLineClassifier::Error ? m_errorLines : m_warningLines;
+}
+
+const std::vector<qint64> &ADTSeverityIndex::getLines(ADTLineClassifier::Severity severity) const
+{
+    return severity == ADTLineClassifier::Error ? m_errorLines : m_warningLines;
+}
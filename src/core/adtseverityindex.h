@@ -0,0 +1,72 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTSEVERITYINDEX_H
+#define ADTSEVERITYINDEX_H
+
+#include "adtlineclassifier.h"
+
+#include <atomic>
+#include <vector>
+#include <QMutex>
+
+/*
+ * Numbers of the log lines flagged by the classifier, kept while the output arrives.
+ * Lines are added by the receiving thread and looked up by the viewer without rescanning the log.
+ */
+class ADTSeverityIndex
+{
+public:
+    ADTSeverityIndex();
+    ~ADTSeverityIndex() = default;
+
+    // Lines are expected in increasing order
+    void add(ADTLineClassifier::Severity severity, qint64 line);
+    void clear();
+
+    quint64 getCount(ADTLineClassifier::Severity severity) const;
+
+    // Returns the first flagged line at or after from, -1 if there isn't one
+    qint64 findNext(ADTLineClassifier::Severity severity, qint64 from) const;
+
+    // Returns the last flagged line before the given one, -1 if there isn't one
+    qint64 findPrevious(ADTLineClassifier::Severity severity, qint64 before) const;
+
+private:
+    std::vector<qint64> &getLines(ADTLineClassifier::Severity severity);
+    const std::vector<qint64> &getLines(ADTLineClassifier::Severity severity) const;
+
+private:
+    mutable QMutex m_mutex;
+
+    std::vector<qint64> m_errorLines;
+    std::vector<qint64> m_warningLines;
+
+    std::atomic<quint64> m_errorCount;
+    std::atomic<quint64> m_warningCount;
+
+private:
+    ADTSeverityIndex(const ADTSeverityIndex &) = delete;
+    ADTSeverityIndex(ADTSeverityIndex &&)      = delete;
+    ADTSeverityIndex &operator=(const ADTSeverityIndex &) = delete;
+    ADTSeverityIndex &operator=(ADTSeverityIndex &&) = delete;
+};
+
+#endif // ADTSEVERITYINDEX_H
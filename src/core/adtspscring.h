@@ -0,0 +1,110 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTSPSCRING_H
+#define ADTSPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ * Capacity is rounded up to a power of two.
+ */
+template<typename T>
+class ADTSpscRing
+{
+public:
+    explicit ADTSpscRing(size_t capacity)
+        : m_items(roundUpToPowerOfTwo(capacity))
+        , m_mask(m_items.size() - 1)
+        , m_head(0)
+        , m_tail(0)
+    {}
+
+    ~ADTSpscRing() = default;
+
+    // Producer side, returns false if the ring is full
+    bool tryPush(T &&item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_head.load(std::memory_order_acquire) == m_items.size())
+        {
+            return false;
+        }
+
+        m_items[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // Consumer side, returns false if the ring is empty
+    bool tryPop(T &item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = std::move(m_items[head & m_mask]);
+        m_items[head & m_mask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool isEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+    size_t getCapacity() const { return m_items.size(); }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 1;
+
+        while (result < value)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+private:
+    std::vector<T> m_items;
+    size_t m_mask;
+
+    // NOTE: head is written only by the consumer, tail only by the producer
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+
+private:
+    ADTSpscRing(const ADTSpscRing &) = delete;
+    ADTSpscRing(ADTSpscRing &&)      = delete;
+    ADTSpscRing &operator=(const ADTSpscRing &) = delete;
+    ADTSpscRing &operator=(ADTSpscRing &&) = delete;
+};
+
+#endif // ADTSPSCRING_H
@@ -0,0 +1,141 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "adtutf8decoder.h"
+
+#include <cstring>
+
+const quint64 ASCII_MASK = 0x8080808080808080ULL;
+
+QString ADTUtf8Decoder::decode(const QByteArray &data)
+{
+    return decode(data.constData(), data.size());
+}
+
+QString ADTUtf8Decoder::decode(const char *data, int size)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+
+    int pos = 0;
+
+    // NOTE: most of the output is ASCII, check 8 bytes at once
+    while (pos + 8 <= size)
+    {
+        quint64 word;
+        memcpy(&word, bytes + pos, sizeof(word));
+
+        if (word & ASCII_MASK)
+        {
+            break;
+        }
+
+        pos += 8;
+    }
+
+    while (pos < size && bytes[pos] < 0x80)
+    {
+        pos++;
+    }
+
+    if (pos == size)
+    {
+        return QString::fromLatin1(data, size);
+    }
+
+    QString result;
+    result.reserve(size);
+    result.append(QLatin1String(data, pos));
+
+    while (pos < size)
+    {
+        int validBegin = pos;
+
+        while (pos < size)
+        {
+            int length = bytes[pos] < 0x80 ? 1 : getSequenceLength(bytes + pos, size - pos);
+
+            if (length == 0)
+            {
+                break;
+            }
+
+            pos += length;
+        }
+
+        if (pos > validBegin)
+        {
+            result.append(QString::fromUtf8(data + validBegin, pos - validBegin));
+        }
+
+        if (pos < size)
+        {
+            // NOTE: an escape like \xNN could not be told from output which contains the same text
+            result.append(QChar::ReplacementCharacter);
+            pos++;
+        }
+    }
+
+    return result;
+}
+
+int ADTUtf8Decoder::getSequenceLength(const unsigned char *data, int size)
+{
+    // See the table of well-formed byte sequences in the Unicode standard, section 3.9
+    unsigned char first = data[0];
+    int length          = 0;
+    unsigned char low   = 0x80;
+    unsigned char high  = 0xBF;
+
+    if (first >= 0xC2 && first <= 0xDF)
+    {
+        length = 2;
+    }
+    else if (first >= 0xE0 && first <= 0xEF)
+    {
+        length = 3;
+        low    = first == 0xE0 ? 0xA0 : 0x80;
+        high   = first == 0xED ? 0x9F : 0xBF;
+    }
+    else if (first >= 0xF0 && first <= 0xF4)
+    {
+        length = 4;
+        low    = first == 0xF0 ? 0x90 : 0x80;
+        high   = first == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (size < length || data[1] < low || data[1] > high)
+    {
+        return 0;
+    }
+
+    for (int i = 2; i < length; i++)
+    {
+        if (data[i] < 0x80 || data[i] > 0xBF)
+        {
+            return 0;
+        }
+    }
+
+    return length;
+}
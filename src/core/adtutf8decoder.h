@@ -0,0 +1,46 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#ifndef ADTUTF8DECODER_H
+#define ADTUTF8DECODER_H
+
+#include <QByteArray>
+#include <QString>
+
+/*
+ * Validating UTF-8 decoder for test output. ASCII is processed a machine word at a time,
+ * each byte which is not valid UTF-8 is replaced with U+FFFD.
+ */
+class ADTUtf8Decoder
+{
+public:
+    static QString decode(const QByteArray &data);
+    static QString decode(const char *data, int size);
+
+private:
+    // Returns length of the valid sequence at the position or 0
+    static int getSequenceLength(const unsigned char *data, int size);
+
+private:
+    ADTUtf8Decoder()  = delete;
+    ~ADTUtf8Decoder() = delete;
+};
+
+#endif // ADTUTF8DECODER_H
@@ -48,6 +48,7 @@ TreeItem::TreeItem(const QList<QVariant> &data, ItemType type, TreeItem *parent)
     , parentItem(parent)
     , icon(QIcon::fromTheme("system-run"))
     , checked(false)
+    , fetched(true)
     , itemType(type)
     , task(nullptr)
 {}
@@ -62,6 +63,11 @@ void TreeItem::appendChild(TreeItem *item)
     childItems.append(item);
 }
 
+void TreeItem::removeChild(int row)
+{
+    delete childItems.takeAt(row);
+}
+
 TreeItem *TreeItem::child(int row)
 {
     return childItems.value(row);
@@ -104,6 +110,16 @@ void TreeItem::setChecked(bool state)
     checked = state;
 }
 
+bool TreeItem::isFetched() const
+{
+    return fetched;
+}
+
+void TreeItem::setFetched(bool state)
+{
+    fetched = state;
+}
+
 ADTExecutable *TreeItem::getExecutable() const
 {
     return task.get();
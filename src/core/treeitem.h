@@ -66,6 +66,7 @@ public:
     ~TreeItem();
 
     void appendChild(TreeItem *child);
+    void removeChild(int row);
 
     TreeItem *child(int row);
     int childCount() const;
@@ -75,6 +76,8 @@ public:
     TreeItem *parent();
     bool isChecked() const;
     void setChecked(bool state);
+    bool isFetched() const;
+    void setFetched(bool state);
 
     ADTExecutable *getExecutable() const;
     void setExecutable(std::unique_ptr<ADTExecutable> executable);
@@ -94,6 +97,8 @@ private:
 
     bool checked;
 
+    bool fetched;
+
     ItemType itemType;
 
     std::unique_ptr<ADTExecutable> task;
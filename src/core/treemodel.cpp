@@ -42,9 +42,15 @@
 #include "adtexecutable.h"
 #include "treeitem.h"
 
+#include <algorithm>
+#include <QDebug>
+#include <QMap>
+
 TreeModel::TreeModel(QObject *parent)
     : QAbstractItemModel(parent)
     , rootItem(nullptr)
+    , testsFetcher()
+    , elementsLocale()
 {
     QList<QVariant> rootData;
     rootData << "Title";
@@ -66,14 +72,186 @@ int TreeModel::columnCount(const QModelIndex &parent) const
         return rootItem->columnCount();
 }
 
+bool TreeModel::hasChildren(const QModelIndex &parent) const
+{
+    if (canFetchMore(parent))
+        return true;
+
+    return QAbstractItemModel::hasChildren(parent);
+}
+
+bool TreeModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (!parent.isValid() || !testsFetcher)
+        return false;
+
+    TreeItem *item = static_cast<TreeItem *>(parent.internalPointer());
+
+    return item->getItemType() == TreeItem::categoryItem && !item->isFetched();
+}
+
+void TreeModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent))
+        return;
+
+    fetchTests(static_cast<TreeItem *>(parent.internalPointer()));
+}
+
+void TreeModel::setTestsFetcher(TestsFetcher fetcher)
+{
+    testsFetcher = fetcher;
+
+    for (int i = 0; i < rootItem->childCount(); i++)
+    {
+        rootItem->child(i)->setFetched(false);
+    }
+}
+
+void TreeModel::fetchTests(TreeItem *toolItem)
+{
+    if (toolItem->isFetched() || !testsFetcher)
+    {
+        return;
+    }
+
+    // NOTE: the flag is set before fetching, so a tool without tests isn't fetched again
+    toolItem->setFetched(true);
+
+    std::vector<std::unique_ptr<ADTExecutable>> tests = testsFetcher(toolItem->getExecutable());
+
+    if (tests.empty())
+    {
+        return;
+    }
+
+    int first = toolItem->childCount();
+
+    beginInsertRows(createIndex(toolItem->row(), 0, toolItem), first, first + static_cast<int>(tests.size()) - 1);
+
+    for (auto &test : tests)
+    {
+        TreeItem *checkItem = new TreeItem(QList<QVariant>{}, TreeItem::checkItem, toolItem);
+
+        toolItem->appendChild(checkItem);
+
+        checkItem->setIcon(test->m_icon);
+        checkItem->setExecutable(std::move(test));
+
+        if (!elementsLocale.isEmpty())
+        {
+            checkItem->setlocaleForExecutable(elementsLocale);
+        }
+    }
+
+    endInsertRows();
+}
+
+void TreeModel::appendTools(std::vector<std::unique_ptr<ADTExecutable>> elements)
+{
+    int count = static_cast<int>(
+        std::count_if(elements.begin(), elements.end(), [](std::unique_ptr<ADTExecutable> &element) {
+            return element->m_type == ADTExecutable::ExecutableType::ToolType;
+        }));
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    int first = rootItem->childCount();
+
+    beginInsertRows(QModelIndex(), first, first + count - 1);
+
+    QMap<QString, TreeItem *> categoriesMap;
+
+    for (auto &element : elements)
+    {
+        if (element->m_type == ADTExecutable::ExecutableType::ToolType)
+        {
+            TreeItem *categoryItem = new TreeItem(QList<QVariant>{}, TreeItem::categoryItem, rootItem);
+
+            rootItem->appendChild(categoryItem);
+
+            categoriesMap[element->m_id] = categoryItem;
+
+            categoryItem->setIcon(element->m_icon);
+            categoryItem->setExecutable(std::move(element));
+        }
+    }
+
+    for (auto &element : elements)
+    {
+        if (!element || element->m_type != ADTExecutable::ExecutableType::TestType)
+        {
+            continue;
+        }
+
+        auto it = categoriesMap.find(element->m_toolId);
+
+        if (it == categoriesMap.end())
+        {
+            qWarning() << "ERROR! Can't find category: " << element->m_toolId << " for element: " << element->m_id;
+
+            continue;
+        }
+
+        TreeItem *checkItem = new TreeItem(QList<QVariant>{}, TreeItem::checkItem, *it);
+
+        (*it)->appendChild(checkItem);
+
+        checkItem->setIcon(element->m_icon);
+        checkItem->setExecutable(std::move(element));
+    }
+
+    if (!elementsLocale.isEmpty())
+    {
+        for (TreeItem *categoryItem : categoriesMap)
+        {
+            setLocaleForItem(categoryItem, elementsLocale);
+        }
+    }
+
+    endInsertRows();
+}
+
+void TreeModel::removeTools(QStringList paths)
+{
+    for (int i = rootItem->childCount() - 1; i >= 0; i--)
+    {
+        if (!paths.contains(rootItem->child(i)->getExecutable()->m_dbusPath))
+        {
+            continue;
+        }
+
+        beginRemoveRows(QModelIndex(), i, i);
+
+        rootItem->removeChild(i);
+
+        endRemoveRows();
+    }
+}
+
 void TreeModel::setLocaleForElements(QString locale)
 {
+    elementsLocale = locale;
+
     for (int i = 0; i < rootItem->childCount(); i++)
     {
         setLocaleForItem(rootItem->child(i), locale);
     }
 }
 
+void TreeModel::moveElementsToThread(QThread *thread)
+{
+    for (int i = 0; i < rootItem->childCount(); i++)
+    {
+        moveItemToThread(rootItem->child(i), thread);
+    }
+
+    moveToThread(thread);
+}
+
 QVariant TreeModel::data(const QModelIndex &index, int role) const
 {
     if (!index.isValid())
@@ -176,3 +354,16 @@ void TreeModel::setLocaleForItem(TreeItem *item, QString locale)
         setLocaleForItem(item->child(i), locale);
     }
 }
+
+void TreeModel::moveItemToThread(TreeItem *item, QThread *thread)
+{
+    if (item->getExecutable())
+    {
+        item->getExecutable()->moveToThread(thread);
+    }
+
+    for (int i = 0; i < item->childCount(); i++)
+    {
+        moveItemToThread(item->child(i), thread);
+    }
+}
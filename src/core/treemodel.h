@@ -43,14 +43,24 @@
 
 #include <QAbstractItemModel>
 #include <QModelIndex>
+#include <QStringList>
+#include <QThread>
 #include <QVariant>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
+class ADTExecutable;
 class TreeItem;
 
 class TreeModel : public QAbstractItemModel
 {
     Q_OBJECT
 
+public:
+    using TestsFetcher = std::function<std::vector<std::unique_ptr<ADTExecutable>>(ADTExecutable *tool)>;
+
 public:
     TreeModel(QObject *parent = 0);
     ~TreeModel();
@@ -62,14 +72,36 @@ public:
     QModelIndex parent(const QModelIndex &index) const;
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+    bool canFetchMore(const QModelIndex &parent) const;
+    void fetchMore(const QModelIndex &parent);
 
     void setLocaleForElements(QString locale);
 
+    // Tests of each tool are fetched on the first request instead of being built with the model
+    void setTestsFetcher(TestsFetcher fetcher);
+
+    // Does nothing if tests of the tool are already fetched
+    void fetchTests(TreeItem *toolItem);
+
+    // Appends tools with their tests, elements are grouped as in TreeModelBulderFromExecutable
+    void appendTools(std::vector<std::unique_ptr<ADTExecutable>> elements);
+
+    // Removes tools of the D-Bus objects with all their tests
+    void removeTools(QStringList paths);
+
+    void moveElementsToThread(QThread *thread);
+
 private:
     TreeItem *rootItem;
 
+    TestsFetcher testsFetcher;
+
+    QString elementsLocale;
+
 private:
     void setLocaleForItem(TreeItem *item, QString locale);
+    void moveItemToThread(TreeItem *item, QThread *thread);
 
 private:
     TreeModel(const TreeModel &) = delete;
@@ -0,0 +1,131 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+
+#include "adtbudgetplanner.h"
+#include "adtrunhistory.h"
+
+#include <memory>
+#include <QtTest>
+
+class ADTBudgetPlannerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void historyRoundTrip();
+    void plansByFailuresPerSecond();
+    void plansWithoutHistory();
+
+private:
+    static std::unique_ptr<ADTExecutable> makeTask(QString id);
+};
+
+std::unique_ptr<ADTExecutable> ADTBudgetPlannerTest::makeTask(QString id)
+{
+    auto task      = std::make_unique<ADTExecutable>();
+    task->m_toolId = "tool";
+    task->m_id     = id;
+
+    return task;
+}
+
+void ADTBudgetPlannerTest::historyRoundTrip()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    auto task = makeTask("test");
+
+    {
+        ADTRunHistory history(directory.filePath("history.json"));
+
+        history.addRun(task.get(), 1000, true);
+        history.addRun(task.get(), 2000, false);
+        history.save();
+    }
+
+    ADTRunHistory history(directory.filePath("history.json"));
+    QVERIFY(history.contains(task.get()));
+
+    ADTRunHistory::Record record = history.getRecord(task.get());
+    QCOMPARE(record.runs, 2);
+    QCOMPARE(record.failures, 1);
+
+    // NOTE: the last run has the weight of 0.3 in the average duration
+    QCOMPARE(record.averageDuration, 1300.0);
+}
+
+void ADTBudgetPlannerTest::plansByFailuresPerSecond()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    ADTRunHistory history(directory.filePath("history.json"));
+
+    auto passing = makeTask("passing");
+    auto failing = makeTask("failing");
+    auto unknown = makeTask("unknown");
+
+    for (int i = 0; i < 3; ++i)
+    {
+        history.addRun(passing.get(), 1000, false);
+        history.addRun(failing.get(), 1000, true);
+    }
+
+    // NOTE: 0.2 and 0.8 failures per run of 1 s, the unknown test has 0.5 per run of the default 5 s
+    ADTBudgetPlanner planner(&history);
+    std::vector<ADTExecutable *> skipped;
+    std::vector<ADTExecutable *> planned = planner.plan({unknown.get(), passing.get(), failing.get()},
+                                                        2500,
+                                                        skipped);
+
+    QCOMPARE(planned.size(), size_t(2));
+    QCOMPARE(planned.at(0), failing.get());
+    QCOMPARE(planned.at(1), passing.get());
+
+    QCOMPARE(skipped.size(), size_t(1));
+    QCOMPARE(skipped.at(0), unknown.get());
+}
+
+void ADTBudgetPlannerTest::plansWithoutHistory()
+{
+    auto first  = makeTask("first");
+    auto second = makeTask("second");
+    auto third  = makeTask("third");
+
+    // NOTE: without history all tests rank the same, so they keep their order
+    ADTBudgetPlanner planner(nullptr);
+    std::vector<ADTExecutable *> skipped;
+    std::vector<ADTExecutable *> planned = planner.plan({first.get(), second.get(), third.get()},
+                                                        2 * ADTBudgetPlanner::DEFAULT_DURATION,
+                                                        skipped);
+
+    QCOMPARE(planned.size(), size_t(2));
+    QCOMPARE(planned.at(0), first.get());
+    QCOMPARE(planned.at(1), second.get());
+
+    QCOMPARE(skipped.size(), size_t(1));
+    QCOMPARE(skipped.at(0), third.get());
+}
+
+QTEST_MAIN(ADTBudgetPlannerTest)
+
+#include "adtbudgetplannertest.moc"
@@ -0,0 +1,166 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+
+#include "adtcatalogcache.h"
+
+#include <QtTest>
+
+class ADTCatalogCacheTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void wrongKeyNotFound();
+    void saveDropsUnlistedObjects();
+    void unchangedCatalogNotSaved();
+    void keyDependsOnTestsAndInfo();
+
+private:
+    static std::vector<std::unique_ptr<ADTExecutable>> makeExecutables(QString toolId, int count);
+};
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTCatalogCacheTest::makeExecutables(QString toolId, int count)
+{
+    std::vector<std::unique_ptr<ADTExecutable>> executables;
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto executable      = std::make_unique<ADTExecutable>();
+        executable->m_id     = QString("test%1").arg(i);
+        executable->m_type   = 0;
+        executable->m_name   = QString("Test %1").arg(i);
+        executable->m_toolId = toolId;
+        executable->m_args   = "--verbose";
+
+        executable->m_dbusPath                       = "/org/altlinux/alterator/" + toolId;
+        executable->m_nameLocaleStorage["ru"]        = QString("Тест %1").arg(i);
+        executable->m_descriptionLocaleStorage["ru"] = "Описание";
+
+        executables.push_back(std::move(executable));
+    }
+
+    return executables;
+}
+
+void ADTCatalogCacheTest::roundTrip()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    {
+        ADTCatalogCache cache(directory.filePath("catalog.json"));
+        QVERIFY(cache.isEmpty());
+
+        cache.setObject("/first", "key1", makeExecutables("first", 2));
+        cache.setObject("/second", "key2", makeExecutables("second", 1));
+
+        QVERIFY(cache.save({"/second", "/first"}));
+    }
+
+    ADTCatalogCache cache(directory.filePath("catalog.json"));
+
+    QVERIFY(!cache.isEmpty());
+    QCOMPARE(cache.getPaths(), QStringList({"/second", "/first"}));
+    QCOMPARE(cache.getKeys(), (QMap<QString, QString>{{"/first", "key1"}, {"/second", "key2"}}));
+
+    std::vector<std::unique_ptr<ADTExecutable>> executables = cache.getExecutables();
+
+    QCOMPARE(executables.size(), size_t(3));
+    QCOMPARE(executables.at(0)->m_toolId, QString("second"));
+    QCOMPARE(executables.at(1)->m_id, QString("test0"));
+    QCOMPARE(executables.at(2)->m_id, QString("test1"));
+
+    std::vector<std::unique_ptr<ADTExecutable>> found = cache.find("/first", "key1");
+
+    QCOMPARE(found.size(), size_t(2));
+    QCOMPARE(found.at(1)->m_id, QString("test1"));
+    QCOMPARE(found.at(1)->m_type, 0);
+    QCOMPARE(found.at(1)->m_name, QString("Test 1"));
+    QCOMPARE(found.at(1)->m_args, QString("--verbose"));
+    QCOMPARE(found.at(1)->m_dbusPath, QString("/org/altlinux/alterator/first"));
+    QCOMPARE(found.at(1)->m_nameLocaleStorage.value("ru"), QString("Тест 1"));
+    QCOMPARE(found.at(1)->m_descriptionLocaleStorage.value("ru"), QString("Описание"));
+}
+
+void ADTCatalogCacheTest::wrongKeyNotFound()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    ADTCatalogCache cache(directory.filePath("catalog.json"));
+    cache.setObject("/first", "key1", makeExecutables("first", 1));
+
+    QCOMPARE(cache.find("/first", "key1").size(), size_t(1));
+    QVERIFY(cache.find("/first", "key2").empty());
+    QVERIFY(cache.find("/second", "key1").empty());
+}
+
+void ADTCatalogCacheTest::saveDropsUnlistedObjects()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    {
+        ADTCatalogCache cache(directory.filePath("catalog.json"));
+
+        cache.setObject("/first", "key1", makeExecutables("first", 1));
+        cache.setObject("/second", "key2", makeExecutables("second", 1));
+
+        QVERIFY(cache.save({"/second"}));
+        QVERIFY(cache.find("/first", "key1").empty());
+    }
+
+    ADTCatalogCache cache(directory.filePath("catalog.json"));
+
+    QCOMPARE(cache.getPaths(), QStringList({"/second"}));
+    QVERIFY(cache.find("/first", "key1").empty());
+    QCOMPARE(cache.find("/second", "key2").size(), size_t(1));
+}
+
+void ADTCatalogCacheTest::unchangedCatalogNotSaved()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    ADTCatalogCache cache(directory.filePath("catalog.json"));
+    cache.setObject("/first", "key1", makeExecutables("first", 1));
+
+    QVERIFY(cache.save({"/first"}));
+    QVERIFY(!cache.save({"/first"}));
+
+    cache.setObject("/first", "key2", makeExecutables("first", 1));
+
+    QVERIFY(cache.save({"/first"}));
+}
+
+void ADTCatalogCacheTest::keyDependsOnTestsAndInfo()
+{
+    QString key = ADTCatalogCache::getKey({"test0", "test1"}, "info");
+
+    QCOMPARE(ADTCatalogCache::getKey({"test0", "test1"}, "info"), key);
+    QVERIFY(ADTCatalogCache::getKey({"test0"}, "info") != key);
+    QVERIFY(ADTCatalogCache::getKey({"test0", "test1"}, "other info") != key);
+}
+
+QTEST_MAIN(ADTCatalogCacheTest)
+
+#include "adtcatalogcachetest.moc"
@@ -0,0 +1,156 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "../core/adtexecutable.h"
+
+#include <QtTest>
+
+class ADTExecutableTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tailOnlyUnderLimit();
+    void tailOnlyOverLimit();
+    void headAndTailUnderLimit();
+    void headAndTailOverLimit();
+    void rerunDiscardsQueuedLines();
+    void fullRingKeepsAllLines();
+
+private:
+    static void feed(ADTExecutable &executable, int count);
+};
+
+void ADTExecutableTest::feed(ADTExecutable &executable, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        // NOTE: every line takes 10 bytes in the store including its line feed
+        executable.receiveOutput(ADTLogStore::Stdout, QString("line %1\n").arg(i, 4, 10, QChar('0')).toUtf8());
+    }
+}
+
+void ADTExecutableTest::tailOnlyUnderLimit()
+{
+    ADTExecutable executable;
+    executable.m_outputTailLimit = 100;
+
+    feed(executable, 5);
+    executable.flushOutput();
+
+    QCOMPARE(executable.getDroppedOutputBytes(), qint64(0));
+    QCOMPARE(executable.m_logStore.getLineCount(), qint64(5));
+    QVERIFY(!executable.getLog().contains("..."));
+    QVERIFY(executable.getLog().startsWith("line 0000\n"));
+}
+
+void ADTExecutableTest::tailOnlyOverLimit()
+{
+    ADTExecutable executable;
+    executable.m_outputTailLimit = 30;
+
+    feed(executable, 10);
+
+    // NOTE: the tail gets to the store only when the test is finished, it is shown live from the executable
+    QCOMPARE(executable.m_logStore.getLineCount(), qint64(0));
+    QCOMPARE(executable.getTailLineCount(), qint64(3));
+    QCOMPARE(executable.getTailLines(0, 3).front().data, QByteArray("line 0007"));
+
+    executable.flushOutput();
+
+    QCOMPARE(executable.getTailLineCount(), qint64(0));
+
+    QCOMPARE(executable.getDroppedOutputBytes(), qint64(70));
+
+    QString log = executable.getLog();
+    QVERIFY(log.contains("70 byte(s) of output were dropped"));
+    QVERIFY(log.endsWith("line 0007\nline 0008\nline 0009\n"));
+    QVERIFY(!log.contains("line 0006"));
+}
+
+void ADTExecutableTest::headAndTailUnderLimit()
+{
+    ADTExecutable executable;
+    executable.m_outputHeadLimit = 30;
+    executable.m_outputTailLimit = 30;
+
+    feed(executable, 6);
+    executable.flushOutput();
+
+    QCOMPARE(executable.getDroppedOutputBytes(), qint64(0));
+    QCOMPARE(executable.m_logStore.getLineCount(), qint64(6));
+    QVERIFY(!executable.getLog().contains("..."));
+}
+
+void ADTExecutableTest::headAndTailOverLimit()
+{
+    ADTExecutable executable;
+    executable.m_outputHeadLimit = 20;
+    executable.m_outputTailLimit = 20;
+
+    feed(executable, 10);
+    executable.flushOutput();
+
+    QCOMPARE(executable.getDroppedOutputBytes(), qint64(60));
+
+    QString log = executable.getLog();
+    QVERIFY(log.startsWith("line 0000\nline 0001\n"));
+    QVERIFY(log.contains("60 byte(s) of output were dropped"));
+    QVERIFY(log.endsWith("line 0008\nline 0009\n"));
+}
+
+void ADTExecutableTest::rerunDiscardsQueuedLines()
+{
+    ADTExecutable executable;
+    QSignalSpy spy(&executable, &ADTExecutable::getStdoutLine);
+
+    feed(executable, 3);
+    executable.clearReports();
+    feed(executable, 2);
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("line 0000"));
+    QCOMPARE(spy.at(1).at(0).toByteArray(), QByteArray("line 0001"));
+    QCOMPARE(executable.m_logStore.getLineCount(), qint64(2));
+}
+
+void ADTExecutableTest::fullRingKeepsAllLines()
+{
+    ADTExecutable executable;
+    QSignalSpy spy(&executable, &ADTExecutable::getStdoutLine);
+
+    // NOTE: nothing is drained while lines are fed, so most of them don't fit into the ring
+    feed(executable, 3000);
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(spy.count(), 3000);
+
+    for (int i = 0; i < spy.count(); ++i)
+    {
+        QCOMPARE(spy.at(i).at(0).toByteArray(), QString("line %1").arg(i, 4, 10, QChar('0')).toUtf8());
+    }
+}
+
+QTEST_MAIN(ADTExecutableTest)
+
+#include "adtexecutabletest.moc"
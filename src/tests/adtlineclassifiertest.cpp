@@ -0,0 +1,70 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+
+#include "../core/adtlineclassifier.h"
+
+#include <QtTest>
+
+class ADTLineClassifierTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void classify_data();
+    void classify();
+};
+
+void ADTLineClassifierTest::classify_data()
+{
+    QTest::addColumn<QByteArray>("line");
+    QTest::addColumn<int>("severity");
+
+    QTest::newRow("error") << QByteArray("ERROR: file not found") << int(ADTLineClassifier::Error);
+    QTest::newRow("failed") << QByteArray("Test failed") << int(ADTLineClassifier::Error);
+    QTest::newRow("errors") << QByteArray("10 errors") << int(ADTLineClassifier::Error);
+    QTest::newRow("error code") << QByteArray("error: 0x1f") << int(ADTLineClassifier::Error);
+    QTest::newRow("warning") << QByteArray("warning: unused variable") << int(ADTLineClassifier::Warning);
+    QTest::newRow("normal") << QByteArray("all checks passed") << int(ADTLineClassifier::Normal);
+
+    QTest::newRow("inside word") << QByteArray("terror") << int(ADTLineClassifier::Normal);
+    QTest::newRow("zero before") << QByteArray("0 errors") << int(ADTLineClassifier::Normal);
+    QTest::newRow("zero after") << QByteArray("failed: 0") << int(ADTLineClassifier::Normal);
+    QTest::newRow("zero assigned") << QByteArray("Errors=0") << int(ADTLineClassifier::Normal);
+    QTest::newRow("zero warnings") << QByteArray("0 warnings") << int(ADTLineClassifier::Normal);
+    QTest::newRow("zero and count") << QByteArray("Tests: 0 failed, 2 errors") << int(ADTLineClassifier::Error);
+    QTest::newRow("zero errors and warnings") << QByteArray("Errors: 0, Warnings: 3")
+                                              << int(ADTLineClassifier::Warning);
+}
+
+void ADTLineClassifierTest::classify()
+{
+    QFETCH(QByteArray, line);
+    QFETCH(int, severity);
+
+    ADTLineClassifier classifier(ADTLineClassifier::DEFAULT_ERROR_PATTERNS,
+                                 ADTLineClassifier::DEFAULT_WARNING_PATTERNS);
+
+    QCOMPARE(int(classifier.classify(line)), severity);
+}
+
+QTEST_MAIN(ADTLineClassifierTest)
+
+#include "adtlineclassifiertest.moc"
@@ -0,0 +1,208 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+
+#include "../core/adtlogstore.h"
+
+#include <QtTest>
+
+class ADTLogStoreTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void spilledChunksReadBack();
+    void spilledLinePagesReadBack();
+    void repeatedLinesCollapse();
+    void repeatedLinesOfOtherStreamNotCollapsed();
+    void blankLinesNotCollapsed();
+    void spilledRepeatsReadBack();
+};
+
+void ADTLogStoreTest::spilledChunksReadBack()
+{
+    ADTLogStore store;
+    store.setMemoryBudget(8 * 1024);
+
+    QByteArray expected;
+    QByteArray expectedStdout;
+
+    // NOTE: streams alternate, so every line of 1000 bytes is a chunk of its own which can be spilled
+    for (int i = 0; i < 200; ++i)
+    {
+        ADTLogStore::Stream stream = i % 2 ? ADTLogStore::Stderr : ADTLogStore::Stdout;
+        QByteArray line            = QString("line %1 ").arg(i, 4, 10, QChar('0')).toUtf8() + QByteArray(989, 'x');
+        line.append('\n');
+
+        store.append(stream, line);
+
+        expected.append(line);
+
+        if (stream == ADTLogStore::Stdout)
+        {
+            expectedStdout.append(line);
+        }
+    }
+
+    QVERIFY(store.getMemorySize() < store.getSize() / 2);
+
+    QCOMPARE(store.readAll(), expected);
+    QCOMPARE(store.readAll(ADTLogStore::Stdout), expectedStdout);
+
+    QCOMPARE(store.getLineCount(), qint64(200));
+
+    for (qint64 i : {qint64(0), qint64(1), qint64(100), qint64(199)})
+    {
+        ADTLogStore::Line line = store.getLine(i);
+
+        QCOMPARE(line.stream, i % 2 ? ADTLogStore::Stderr : ADTLogStore::Stdout);
+        QCOMPARE(line.offset, i * 1000);
+        QCOMPARE(line.data, expected.mid(static_cast<int>(i) * 1000, 999));
+    }
+}
+
+void ADTLogStoreTest::spilledLinePagesReadBack()
+{
+    ADTLogStore store;
+    store.setMemoryBudget(1);
+
+    const qint64 lineCount = 3 * static_cast<qint64>(ADTLogStore::LINE_PAGE_SIZE) + 10;
+
+    for (qint64 i = 0; i < lineCount; ++i)
+    {
+        store.append(ADTLogStore::Stdout, QString("line %1\n").arg(i, 5, 10, QChar('0')).toUtf8());
+    }
+
+    QCOMPARE(store.getLineCount(), lineCount);
+
+    // NOTE: only the last chunk and the last page of 16 bytes per line are kept in memory
+    QVERIFY(store.getMemorySize()
+            <= ADTLogStore::CHUNK_COALESCE_LIMIT + static_cast<qint64>(ADTLogStore::LINE_PAGE_SIZE) * 16);
+
+    for (qint64 i : {qint64(0), static_cast<qint64>(ADTLogStore::LINE_PAGE_SIZE), lineCount - 1})
+    {
+        QCOMPARE(store.getLine(i).data, QString("line %1").arg(i, 5, 10, QChar('0')).toUtf8());
+    }
+
+    // NOTE: the lines span the boundary of two spilled pages
+    const qint64 from                    = static_cast<qint64>(ADTLogStore::LINE_PAGE_SIZE) - 5;
+    std::vector<ADTLogStore::Line> lines = store.getLines(from, 10);
+
+    QCOMPARE(lines.size(), size_t(10));
+
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        QCOMPARE(lines[i].data, QString("line %1").arg(from + static_cast<qint64>(i), 5, 10, QChar('0')).toUtf8());
+        QCOMPARE(lines[i].repeats, quint64(1));
+    }
+}
+
+void ADTLogStoreTest::repeatedLinesCollapse()
+{
+    ADTLogStore store;
+
+    store.append(ADTLogStore::Stdout, "first\n");
+
+    for (int i = 0; i < 5; ++i)
+    {
+        store.append(ADTLogStore::Stdout, "waiting\n");
+    }
+
+    store.append(ADTLogStore::Stdout, "last\n");
+
+    QCOMPARE(store.getLineCount(), qint64(3));
+    QCOMPARE(store.getLine(0).repeats, quint64(1));
+    QCOMPARE(store.getLine(1).repeats, quint64(5));
+    QCOMPARE(store.getLine(1).data, QByteArray("waiting"));
+    QCOMPARE(store.getLine(2).repeats, quint64(1));
+
+    QCOMPARE(store.readAll(ADTLogStore::All, ADTLogStore::ExpandRepeats),
+             QByteArray("first\nwaiting\nwaiting\nwaiting\nwaiting\nwaiting\nlast\n"));
+    QCOMPARE(store.readAll(ADTLogStore::All, ADTLogStore::CollapseRepeats),
+             QByteArray("first\nwaiting") + ADTLogStore::getRepeatSuffix(5) + "last\n");
+}
+
+void ADTLogStoreTest::repeatedLinesOfOtherStreamNotCollapsed()
+{
+    ADTLogStore store;
+
+    store.append(ADTLogStore::Stdout, "waiting\n");
+    store.append(ADTLogStore::Stderr, "waiting\n");
+
+    QCOMPARE(store.getLineCount(), qint64(2));
+    QCOMPARE(store.getLine(0).repeats, quint64(1));
+    QCOMPARE(store.getLine(1).repeats, quint64(1));
+}
+
+void ADTLogStoreTest::blankLinesNotCollapsed()
+{
+    ADTLogStore store;
+
+    QByteArray output;
+
+    for (const char *line : {"first\n", "\n", "\n", "  \n", "  \n", "last\n"})
+    {
+        store.append(ADTLogStore::Stdout, line);
+        output.append(line);
+    }
+
+    QCOMPARE(store.getLineCount(), qint64(6));
+
+    for (const ADTLogStore::Line &line : store.getLines(0, 6))
+    {
+        QCOMPARE(line.repeats, quint64(1));
+    }
+
+    QCOMPARE(store.readAll(ADTLogStore::All, ADTLogStore::CollapseRepeats), output);
+}
+
+void ADTLogStoreTest::spilledRepeatsReadBack()
+{
+    ADTLogStore store;
+    store.setMemoryBudget(1);
+
+    const qint64 lineCount = 2 * static_cast<qint64>(ADTLogStore::LINE_PAGE_SIZE) + 10;
+    QByteArray expected;
+
+    for (qint64 i = 0; i < lineCount; ++i)
+    {
+        QByteArray line = QString("line %1\n").arg(i, 5, 10, QChar('0')).toUtf8();
+
+        // NOTE: every 1000th line has two more copies, so both spilled pages have repeats
+        for (int copy = 0; copy < (i % 1000 ? 1 : 3); ++copy)
+        {
+            store.append(ADTLogStore::Stdout, line);
+            expected.append(line);
+        }
+    }
+
+    QCOMPARE(store.getLineCount(), lineCount);
+
+    for (qint64 i = 0; i < lineCount; ++i)
+    {
+        QCOMPARE(store.getLine(i).repeats, quint64(i % 1000 ? 1 : 3));
+    }
+
+    QCOMPARE(store.readAll(ADTLogStore::All, ADTLogStore::ExpandRepeats), expected);
+}
+
+QTEST_MAIN(ADTLogStoreTest)
+
+#include "adtlogstoretest.moc"
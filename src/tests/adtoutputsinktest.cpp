@@ -0,0 +1,59 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "../core/adtoutputsink.h"
+
+#include <memory>
+#include <QtTest>
+
+class ADTOutputSinkTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dropsLinesAboveQueueLimit();
+};
+
+void ADTOutputSinkTest::dropsLinesAboveQueueLimit()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    // NOTE: the queue is empty before the first write, so only the line above the limit is dropped for sure
+    auto sink = std::make_unique<ADTOutputSink>(directory.path(), 16);
+    int file  = sink->open("tool", "test");
+
+    sink->write(file, "kept");
+    sink->write(file, "dropped because it doesn't fit into the queue");
+    sink->close(file);
+
+    QCOMPARE(sink->getDroppedBytes(), qint64(46));
+
+    // NOTE: the writer writes everything which is queued before the sink is deleted
+    sink.reset();
+
+    QFile log(directory.filePath("tool/test.log"));
+    QVERIFY(log.open(QIODevice::ReadOnly));
+    QCOMPARE(log.readAll(), QByteArray("kept\n"));
+}
+
+QTEST_MAIN(ADTOutputSinkTest)
+
+#include "adtoutputsinktest.moc"
@@ -0,0 +1,162 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+
+#include "adttaskqueue.h"
+
+#include <memory>
+#include <QtTest>
+
+class ADTTaskQueueTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void equalWeightsAlternate();
+    void weightedInterleaving();
+    void returnedTaskKeepsSchedule();
+    void busyToolPassedOver();
+    void rankedTasksKeepOrder();
+
+private:
+    // Tasks of the given tools in the given order, e.g. "aab" are two tasks of tool "a" and one of tool "b"
+    static std::vector<std::unique_ptr<ADTExecutable>> makeTasks(QString toolIds);
+    static std::vector<ADTExecutable *> getPointers(const std::vector<std::unique_ptr<ADTExecutable>> &tasks);
+
+    // Tool ids of the tasks taken until the queue has no tasks of free tools
+    static QString takeAll(ADTTaskQueue &queue);
+};
+
+std::vector<std::unique_ptr<ADTExecutable>> ADTTaskQueueTest::makeTasks(QString toolIds)
+{
+    std::vector<std::unique_ptr<ADTExecutable>> tasks;
+
+    for (int i = 0; i < toolIds.size(); ++i)
+    {
+        auto task      = std::make_unique<ADTExecutable>();
+        task->m_toolId = toolIds.at(i);
+        task->m_id     = QString::number(i);
+
+        tasks.push_back(std::move(task));
+    }
+
+    return tasks;
+}
+
+std::vector<ADTExecutable *> ADTTaskQueueTest::getPointers(const std::vector<std::unique_ptr<ADTExecutable>> &tasks)
+{
+    std::vector<ADTExecutable *> pointers;
+
+    for (const auto &task : tasks)
+    {
+        pointers.push_back(task.get());
+    }
+
+    return pointers;
+}
+
+QString ADTTaskQueueTest::takeAll(ADTTaskQueue &queue)
+{
+    QString toolIds;
+
+    while (ADTExecutable *task = queue.takeNextTask())
+    {
+        toolIds.append(task->m_toolId);
+    }
+
+    return toolIds;
+}
+
+void ADTTaskQueueTest::equalWeightsAlternate()
+{
+    auto tasks = makeTasks("aaabb");
+
+    ADTTaskQueue queue;
+    queue.setTasks(getPointers(tasks), false);
+
+    QCOMPARE(takeAll(queue), QString("ababa"));
+    QVERIFY(queue.isEmpty());
+}
+
+void ADTTaskQueueTest::weightedInterleaving()
+{
+    auto tasks = makeTasks("aaaabb");
+
+    ADTTaskQueue queue;
+    queue.setToolWeight("a", 2);
+    queue.setTasks(getPointers(tasks), false);
+
+    // NOTE: the smooth weighted round-robin spreads the larger share instead of running it in a row
+    QCOMPARE(takeAll(queue), QString("abaaba"));
+}
+
+void ADTTaskQueueTest::returnedTaskKeepsSchedule()
+{
+    auto tasks = makeTasks("aaaabb");
+
+    ADTTaskQueue queue;
+    queue.setToolWeight("a", 2);
+    queue.setTasks(getPointers(tasks), false);
+
+    ADTExecutable *task = queue.takeNextTask();
+    QCOMPARE(task, tasks.at(0).get());
+
+    queue.returnTask(task);
+
+    QCOMPARE(queue.takeNextTask(), tasks.at(0).get());
+    QCOMPARE(takeAll(queue), QString("baaba"));
+}
+
+void ADTTaskQueueTest::busyToolPassedOver()
+{
+    auto tasks = makeTasks("aabb");
+
+    ADTTaskQueue queue;
+    queue.setTasks(getPointers(tasks), false);
+    queue.setToolBusy("a", true);
+
+    QCOMPARE(takeAll(queue), QString("bb"));
+    QVERIFY(!queue.isEmpty());
+
+    queue.setToolBusy("a", false);
+
+    QCOMPARE(takeAll(queue), QString("aa"));
+    QVERIFY(queue.isEmpty());
+}
+
+void ADTTaskQueueTest::rankedTasksKeepOrder()
+{
+    auto tasks = makeTasks("baab");
+
+    ADTTaskQueue queue;
+    queue.setToolWeight("a", 10);
+    queue.setTasks(getPointers(tasks), true);
+
+    for (const auto &task : tasks)
+    {
+        QCOMPARE(queue.takeNextTask(), task.get());
+    }
+
+    QCOMPARE(queue.takeNextTask(), static_cast<ADTExecutable *>(nullptr));
+}
+
+QTEST_MAIN(ADTTaskQueueTest)
+
+#include "adttaskqueuetest.moc"
@@ -0,0 +1,100 @@
+/***********************************************************************************************************************
+**
+** Copyright (C) 2024 BaseALT Ltd. <org@basealt.ru>
+**
+** This program is free software; you can redistribute it and/or
+** modify it under the terms of the GNU General Public License
+** as published by the Free Software Foundation; either version 2
+** of the License, or (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**
+***********************************************************************************************************************/
+
+#include "../core/treeitem.h"
+#include "../core/treemodel.h"
+#include "../core/treemodelbulderfromexecutable.h"
+#include "adttoolobjecthelper.h"
+#include "mainwindow/maintestswidget.h"
+#include "mainwindow/statuscommonwidget.h"
+
+#include <memory>
+#include <QtTest>
+
+class MainTestsWidgetTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void removeShownTool();
+
+private:
+    static std::unique_ptr<TreeModel> buildModel();
+};
+
+std::unique_ptr<TreeModel> MainTestsWidgetTest::buildModel()
+{
+    std::vector<std::unique_ptr<ADTExecutable>> elements;
+
+    std::unique_ptr<ADTExecutable> tool = std::make_unique<ADTExecutable>();
+    tool->m_id                          = "tool";
+    tool->m_toolId                      = "tool";
+    tool->m_name                        = "tool";
+    tool->m_type                        = ADTExecutable::ExecutableType::ToolType;
+    tool->m_dbusPath                    = "/tool";
+    elements.push_back(std::move(tool));
+
+    for (QString name : QStringList() << "first"
+                                      << "second")
+    {
+        std::unique_ptr<ADTExecutable> test = std::make_unique<ADTExecutable>();
+        test->m_id                          = name;
+        test->m_toolId                      = "tool";
+        test->m_name                        = name;
+        test->m_type                        = ADTExecutable::ExecutableType::TestType;
+        test->m_dbusPath                    = "/tool";
+        elements.push_back(std::move(test));
+    }
+
+    TreeModelBulderFromExecutable builder;
+
+    return builder.buildModel(std::move(elements));
+}
+
+void MainTestsWidgetTest::removeShownTool()
+{
+    std::unique_ptr<TreeModel> model = buildModel();
+
+    TreeItem *toolItem = static_cast<TreeItem *>(model->index(0, 0).internalPointer());
+
+    std::unique_ptr<ADTToolObjectHelper> helper = std::make_unique<ADTToolObjectHelper>(model.get(), toolItem);
+
+    MainTestsWidget widget;
+    widget.setToolObjectHelper(helper.get());
+
+    QCOMPARE(widget.findChildren<StatusCommonWidget *>().size(), 2);
+
+    // NOTE: the same order as in MainWindowControllerImpl::applyObjectChanges
+    widget.setToolObjectHelper(nullptr);
+    helper.reset();
+    model->removeTools(QStringList() << "/tool");
+
+    QCOMPARE(model->rowCount(), 0);
+    QVERIFY(widget.findChildren<StatusCommonWidget *>().isEmpty());
+
+    // NOTE: these calls used deleted status widgets before
+    widget.setEnabledRunButtonOfStatusWidgets(true);
+    widget.disableButtons();
+    widget.enableButtons();
+}
+
+QTEST_MAIN(MainTestsWidgetTest)
+
+#include "maintestswidgettest.moc"